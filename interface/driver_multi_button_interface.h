@@ -79,6 +79,16 @@ uint8_t multi_button_interface_matrix_deinit(void);
  */
 uint8_t multi_button_interface_matrix_write_row(uint16_t num, uint8_t level);
 
+/**
+ * @brief     interface matrix select row
+ * @param[in] row selected row
+ * @return    status code
+ *            - 0 success
+ *            - 1 select failed
+ * @note      optional, drive the row low and all the other rows high at once
+ */
+uint8_t multi_button_interface_matrix_select_row(uint16_t row);
+
 /**
  * @brief      interface matrix read row
  * @param[out] *col_array pointer to a col array buffer
@@ -89,6 +99,17 @@ uint8_t multi_button_interface_matrix_write_row(uint16_t num, uint8_t level);
  */
 uint8_t multi_button_interface_matrix_read_row(uint32_t *col_array);
 
+/**
+ * @brief         interface matrix read row with the edge timestamps
+ * @param[out]    *col_array pointer to a col array buffer
+ * @param[in,out] *t pointer to a col time array
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ * @note          optional, overwrite the time of each col whose edge is captured
+ */
+uint8_t multi_button_interface_matrix_read_row_timestamp(uint32_t *col_array, multi_button_time_t *t);
+
 /**
  * @brief     interface timestamp read
  * @param[in] *t pointer to a multi_button_time structure
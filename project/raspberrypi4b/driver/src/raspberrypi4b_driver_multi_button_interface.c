@@ -36,7 +36,7 @@
 
 #include "driver_multi_button_interface.h"
 #include "gpio.h"
-#include <sys/time.h>
+#include "clock.h"
 #include <unistd.h>
 #include <stdarg.h>
 
@@ -78,6 +78,19 @@ uint8_t multi_button_interface_matrix_write_row(uint16_t num, uint8_t level)
     return gpio_matrix_write_row(num, level);
 }
 
+/**
+ * @brief     interface matrix select row
+ * @param[in] row selected row
+ * @return    status code
+ *            - 0 success
+ *            - 1 select failed
+ * @note      none
+ */
+uint8_t multi_button_interface_matrix_select_row(uint16_t row)
+{
+    return gpio_matrix_select_row(row);
+}
+
 /**
  * @brief      interface matrix read row
  * @param[out] *col_array pointer to a col array buffer
@@ -91,25 +104,56 @@ uint8_t multi_button_interface_matrix_read_row(uint32_t *col_array)
     return gpio_matrix_read_row(col_array);
 }
 
+/**
+ * @brief         interface matrix read row with the edge timestamps
+ * @param[out]    *col_array pointer to a col array buffer
+ * @param[in,out] *t pointer to a col time array
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ * @note          the kernel edge time is in the same clock as the timestamp_read
+ */
+uint8_t multi_button_interface_matrix_read_row_timestamp(uint32_t *col_array, multi_button_time_t *t)
+{
+    uint8_t i;
+    uint64_t ns[32] = {0};
+    
+    if (gpio_matrix_read_row_timestamp(col_array, ns) != 0)
+    {
+        return 1;
+    }
+    for (i = 0; i < 32; i++)
+    {
+        if (ns[i] != 0)
+        {
+            t[i].s = ns[i] / 1000000000ULL;
+            t[i].us = (uint32_t)((ns[i] % 1000000000ULL) / 1000);
+        }
+    }
+    
+    return 0;
+}
+
 /**
  * @brief     interface timestamp read
  * @param[in] *t pointer to a multi_button_time structure
  * @return    status code
  *            - 0 success
  *            - 1 read failed
- * @note      none
+ * @note      the source is selected by clock_set_source and is CLOCK_MONOTONIC by default
  */
 uint8_t multi_button_interface_timestamp_read(multi_button_time_t *t)
 {
-    struct timeval time_s;
+    uint64_t s;
+    uint32_t us;
     
-    if (gettimeofday(&time_s, NULL) < 0)
+    if (clock_read(&s, &us) != 0)
     {
         return 1;
     }
 
-    t->s = time_s.tv_sec;
-    t->us = time_s.tv_usec;
+    t->s = s;
+    t->us = us;
     
     return 0;
 }
@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ * @file      client.h
+ * @brief     client header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef CLIENT_H
+#define CLIENT_H
+
+#include "protocol.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup client client function
+ * @brief    client function modules
+ * @{
+ */
+
+/**
+ * @brief client buffer size definition
+ */
+#define CLIENT_BUFFER_SIZE        (32 * PROTOCOL_RECORD_SIZE)        /**< bytes read per recv */
+
+/**
+ * @brief client handle structure definition
+ */
+typedef struct client_handle_s
+{
+    int fd;                                  /**< socket, -1 means closed */
+    uint8_t buf[CLIENT_BUFFER_SIZE];         /**< receive buffer */
+    uint32_t start;                          /**< first unread byte */
+    uint32_t end;                            /**< end of the received bytes */
+    uint8_t seq_valid;                       /**< seq valid flag */
+    uint32_t seq;                            /**< last received seq */
+    uint32_t lost;                           /**< records lost by the server */
+} client_handle_t;
+
+/**
+ * @brief     client open
+ * @param[in] *handle pointer to a client handle structure
+ * @param[in] *path pointer to a unix socket path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 4 path is too long
+ * @note      none
+ */
+uint8_t client_open(client_handle_t *handle, const char *path);
+
+/**
+ * @brief     client close
+ * @param[in] *handle pointer to a client handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      none
+ */
+uint8_t client_close(client_handle_t *handle);
+
+/**
+ * @brief     client get the pollable file descriptor
+ * @param[in] *handle pointer to a client handle structure
+ * @return    file descriptor, -1 means closed
+ * @note      call client_read until it returns 2 after the fd is readable,
+ *            the buffered records do not make the fd readable
+ */
+int client_get_fd(client_handle_t *handle);
+
+/**
+ * @brief      client read a record
+ * @param[in]  *handle pointer to a client handle structure
+ * @param[out] *record pointer to a record buffer
+ * @param[in]  timeout_ms wait time in ms, 0 means no wait and -1 means forever
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed or the server is gone
+ *             - 2 no record
+ * @note       none
+ */
+uint8_t client_read(client_handle_t *handle, protocol_record_t *record, int timeout_ms);
+
+/**
+ * @brief      client get the lost record count
+ * @param[in]  *handle pointer to a client handle structure
+ * @param[out] *cnt pointer to a count buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the server drops the oldest records of a slow client, the gaps of seq are counted
+ */
+uint8_t client_get_lost(client_handle_t *handle, uint32_t *cnt);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
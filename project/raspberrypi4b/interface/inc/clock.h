@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ * @file      clock.h
+ * @brief     clock header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup clock clock function
+ * @brief    clock function modules
+ * @{
+ */
+
+/**
+ * @brief clock source enumeration definition
+ */
+typedef enum
+{
+    CLOCK_SOURCE_MONOTONIC     = 0x00,        /**< CLOCK_MONOTONIC, slewed by ntp but never stepped */
+    CLOCK_SOURCE_MONOTONIC_RAW = 0x01,        /**< CLOCK_MONOTONIC_RAW, the raw hardware rate */
+    CLOCK_SOURCE_REALTIME      = 0x02,        /**< CLOCK_REALTIME, the wall clock which can step */
+} clock_source_t;
+
+/**
+ * @brief     clock set the timestamp source
+ * @param[in] source clock source
+ * @note      call it before the driver init, the default is CLOCK_SOURCE_MONOTONIC
+ */
+void clock_set_source(clock_source_t source);
+
+/**
+ * @brief  clock get the timestamp source
+ * @return clock source
+ * @note   none
+ */
+clock_source_t clock_get_source(void);
+
+/**
+ * @brief      clock parse a source name
+ * @param[in]  *str pointer to a name, "monotonic", "raw" or "realtime"
+ * @param[out] *source pointer to a clock source buffer
+ * @return     status code
+ *             - 0 success
+ *             - 4 name is invalid
+ * @note       none
+ */
+uint8_t clock_parse(const char *str, clock_source_t *source);
+
+/**
+ * @brief     clock get the source name
+ * @param[in] source clock source
+ * @return    pointer to the name
+ * @note      none
+ */
+const char *clock_get_name(clock_source_t source);
+
+/**
+ * @brief      clock read the timestamp
+ * @param[out] *s pointer to a second buffer
+ * @param[out] *us pointer to a microsecond buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t clock_read(uint64_t *s, uint32_t *us);
+
+/**
+ * @brief      clock benchmark the read cost of a source
+ * @param[in]  source clock source
+ * @param[in]  times read times
+ * @param[out] *ns pointer to a read cost buffer in ns
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 4 times is 0
+ * @note       the loop is timed with CLOCK_MONOTONIC
+ */
+uint8_t clock_benchmark(clock_source_t source, uint32_t times, double *ns);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -40,6 +40,7 @@
 #include <unistd.h>
 #include <stdint.h>
 #include <stdio.h>
+#include "pinmap.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -51,6 +52,16 @@
  * @{
  */
 
+/**
+ * @brief     gpio matrix set the pin map
+ * @param[in] *map pointer to a pinmap structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      call it before gpio_matrix_init, the default 4x4 map is used if it is not called
+ */
+uint8_t gpio_matrix_set_map(const pinmap_t *map);
+
 /**
  * @brief  gpio matrix init
  * @return status code
@@ -71,6 +82,16 @@ uint8_t gpio_matrix_init(void);
  */
 uint8_t gpio_matrix_write_row(uint16_t num, uint8_t level);
 
+/**
+ * @brief     gpio select row
+ * @param[in] row selected row
+ * @return    status code
+ *            - 0 success
+ *            - 1 select failed
+ * @note      the row is set low and all the other rows high with one bulk set
+ */
+uint8_t gpio_matrix_select_row(uint16_t row);
+
 /**
  * @brief      gpio matrix read row
  * @param[out] *col_array pointer to a col array buffer
@@ -81,6 +102,18 @@ uint8_t gpio_matrix_write_row(uint16_t num, uint8_t level);
  */
 uint8_t gpio_matrix_read_row(uint32_t *col_array);
 
+/**
+ * @brief      gpio matrix read row with the edge timestamps
+ * @param[out] *col_array pointer to a col array buffer
+ * @param[out] *timestamp_ns pointer to a col timestamp array
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       timestamp_ns must be cleared to 0 before the call, the first edge of each col
+ *             captured since the row was selected is saved in ns, the other cols are not changed
+ */
+uint8_t gpio_matrix_read_row_timestamp(uint32_t *col_array, uint64_t *timestamp_ns);
+
 /**
  * @brief  gpio matrix deinit
  * @return status code
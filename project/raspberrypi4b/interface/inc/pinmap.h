@@ -0,0 +1,127 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      pinmap.h
+ * @brief     pinmap header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef PINMAP_H
+#define PINMAP_H
+
+#include <unistd.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup pinmap pinmap function
+ * @brief    pinmap function modules
+ * @{
+ */
+
+/**
+ * @brief pinmap max line number definition
+ */
+#define PINMAP_MAX_LINE        32        /**< max 32 rows or cols */
+
+/**
+ * @brief pinmap chip name size definition
+ */
+#define PINMAP_CHIP_SIZE       64        /**< max chip path length */
+
+/**
+ * @brief pinmap structure definition
+ */
+typedef struct pinmap_s
+{
+    char chip[PINMAP_CHIP_SIZE];            /**< gpio chip path */
+    unsigned int row[PINMAP_MAX_LINE];      /**< row line offsets */
+    unsigned int col[PINMAP_MAX_LINE];      /**< col line offsets */
+    uint8_t row_num;                        /**< row number */
+    uint8_t col_num;                        /**< col number */
+} pinmap_t;
+
+/**
+ * @brief      pinmap init with the default 4x4 map
+ * @param[out] *map pointer to a pinmap structure
+ * @note       rows are GPIO17/27/22/5 and cols are GPIO6/13/19/26 of /dev/gpiochip0
+ */
+void pinmap_init(pinmap_t *map);
+
+/**
+ * @brief      pinmap parse a line list
+ * @param[in]  *str pointer to a list such as "17,27,22,5"
+ * @param[out] *line pointer to a line offset array with PINMAP_MAX_LINE entries
+ * @param[out] *num pointer to a line number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 4 list is invalid
+ * @note       the offsets are separated with commas or spaces
+ */
+uint8_t pinmap_parse_list(const char *str, unsigned int *line, uint8_t *num);
+
+/**
+ * @brief         pinmap load a map file
+ * @param[in,out] *map pointer to a pinmap structure
+ * @param[in]     *path pointer to a map file path
+ * @return        status code
+ *                - 0 success
+ *                - 1 open failed
+ *                - 4 file is invalid
+ * @note          each line is "chip <path>", "row <offsets>" or "col <offsets>",
+ *                '#' starts a comment and the keys not in the file are not changed
+ */
+uint8_t pinmap_load(pinmap_t *map, const char *path);
+
+/**
+ * @brief     pinmap check
+ * @param[in] *map pointer to a pinmap structure
+ * @return    status code
+ *            - 0 success
+ *            - 4 no row or col
+ *            - 5 line is used twice
+ * @note      none
+ */
+uint8_t pinmap_check(const pinmap_t *map);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ * @file      protocol.h
+ * @brief     protocol header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup protocol protocol function
+ * @brief    protocol function modules
+ * @{
+ */
+
+/**
+ * @brief protocol default socket path definition
+ */
+#define PROTOCOL_DEFAULT_PATH        "/tmp/multi_button.sock"        /**< default unix socket path */
+
+/**
+ * @brief protocol record structure definition
+ * @note  the records are streamed back to back in the host byte order,
+ *        a gap of seq means the server dropped records of this client
+ */
+typedef struct protocol_record_s
+{
+    uint32_t seq;                /**< event sequence number */
+    uint16_t row;                /**< button row */
+    uint16_t col;                /**< button col */
+    uint16_t status;             /**< event status */
+    uint16_t times;              /**< click times */
+    uint32_t id;                 /**< speculative gesture id, 0 means none */
+    uint64_t s;                  /**< event time second */
+    uint32_t us;                 /**< event time microsecond */
+    uint32_t duration_us;        /**< press or hold duration in us */
+} protocol_record_t;
+
+/**
+ * @brief protocol record size definition
+ */
+#define PROTOCOL_RECORD_SIZE         32        /**< bytes of one record */
+
+#ifndef __cplusplus
+_Static_assert(sizeof(protocol_record_t) == PROTOCOL_RECORD_SIZE, "protocol record must be 32 bytes");
+#endif
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scan.h
+ * @brief     scan header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SCAN_H
+#define SCAN_H
+
+#include <unistd.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup scan scan function
+ * @brief    scan function modules
+ * @{
+ */
+
+/**
+ * @brief scan param structure definition
+ */
+typedef struct scan_param_s
+{
+    uint32_t period_us;        /**< scan period in us */
+    int32_t priority;          /**< SCHED_FIFO priority, 0 means the default policy */
+    int32_t cpu;               /**< cpu affinity, -1 means no affinity */
+    uint8_t lock_memory;       /**< lock all memory with mlockall */
+} scan_param_t;
+
+/**
+ * @brief scan stat structure definition
+ */
+typedef struct scan_stat_s
+{
+    uint64_t cycle;            /**< scan cycles */
+    uint64_t overrun;          /**< missed periods */
+    uint32_t jitter_min_ns;    /**< min wake up latency in ns */
+    uint32_t jitter_max_ns;    /**< max wake up latency in ns */
+    uint32_t jitter_avg_ns;    /**< average wake up latency in ns */
+} scan_stat_t;
+
+/**
+ * @brief     scan start
+ * @param[in] *param pointer to a scan param structure
+ * @param[in] *process pointer to a process function address
+ * @param[in] *arg pointer to the process argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 4 set priority failed
+ *            - 5 set affinity failed
+ *            - 6 lock memory failed
+ * @note      the process runs on absolute deadlines of CLOCK_MONOTONIC,
+ *            so the processing time doesn't drift the period
+ */
+uint8_t scan_start(const scan_param_t *param, void (*process)(void *arg), void *arg);
+
+/**
+ * @brief  scan stop
+ * @return status code
+ *         - 0 success
+ *         - 1 stop failed
+ * @note   none
+ */
+uint8_t scan_stop(void);
+
+/**
+ * @brief      scan get the period jitter stat
+ * @param[out] *stat pointer to a scan stat structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       jitter is the wake up time minus the deadline
+ */
+uint8_t scan_get_stat(scan_stat_t *stat);
+
+/**
+ * @brief  scan clear the period jitter stat
+ * @return status code
+ *         - 0 success
+ *         - 1 clear failed
+ * @note   none
+ */
+uint8_t scan_clear_stat(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ * @file      server.h
+ * @brief     server header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "driver_multi_button.h"
+#include "protocol.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup server server function
+ * @brief    server function modules
+ * @{
+ */
+
+/**
+ * @brief server client ring size definition
+ */
+#ifndef SERVER_RING_SIZE
+    #define SERVER_RING_SIZE        64        /**< records queued for each client */
+#endif
+
+/**
+ * @brief server socket send buffer definition
+ */
+#ifndef SERVER_SOCKET_BUFFER
+    #define SERVER_SOCKET_BUFFER    8192      /**< kernel send buffer of each client in bytes */
+#endif
+
+/**
+ * @brief server stat structure definition
+ */
+typedef struct server_stat_s
+{
+    uint32_t client;           /**< connected clients */
+    uint64_t accepted;         /**< accepted clients */
+    uint64_t rejected;         /**< clients rejected when full */
+    uint64_t published;        /**< published events */
+    uint64_t dropped;          /**< records dropped for slow clients */
+    uint64_t pending;          /**< records queued in the client rings */
+} server_stat_t;
+
+/**
+ * @brief     server init
+ * @param[in] *path pointer to a unix socket path
+ * @param[in] max_client max client number
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 4 param is invalid
+ * @note      an existing socket file of the path is removed
+ */
+uint8_t server_init(const char *path, uint16_t max_client);
+
+/**
+ * @brief  server deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   all clients are closed and the socket file is removed
+ */
+uint8_t server_deinit(void);
+
+/**
+ * @brief  server get the pollable file descriptor
+ * @return file descriptor, -1 means not initialized
+ * @note   the fd is the epoll fd and is readable while server_process has work
+ */
+int server_get_fd(void);
+
+/**
+ * @brief     server process the sockets
+ * @param[in] timeout_ms wait time in ms, 0 means no wait and -1 means forever
+ * @return    status code
+ *            - 0 success
+ *            - 1 process failed
+ * @note      accepts the new clients, flushes the client rings and closes the hung up clients
+ */
+uint8_t server_process(int timeout_ms);
+
+/**
+ * @brief     server publish an event to all clients
+ * @param[in] *event pointer to an event structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 publish failed
+ * @note      the record is queued in each client ring and sent without blocking,
+ *            a full ring drops its oldest unsent record
+ */
+uint8_t server_publish(const multi_button_event_t *event);
+
+/**
+ * @brief      server get the stat
+ * @param[out] *stat pointer to a stat structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       none
+ */
+uint8_t server_get_stat(server_stat_t *stat);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      service.h
+ * @brief     service header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SERVICE_H
+#define SERVICE_H
+
+#include "driver_multi_button.h"
+#include "scan.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup service service function
+ * @brief    service function modules
+ * @{
+ */
+
+/**
+ * @brief     service init
+ * @param[in] row max row of buttons
+ * @param[in] col max col of buttons
+ * @param[in] *param pointer to a scan param structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the scan thread pushes events into the driver event ring and signals an eventfd
+ */
+uint8_t service_init(uint8_t row, uint8_t col, const scan_param_t *param);
+
+/**
+ * @brief  service deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t service_deinit(void);
+
+/**
+ * @brief  service get the pollable file descriptor
+ * @return file descriptor, -1 means not initialized
+ * @note   the fd is readable while events are pending,
+ *         it is cleared by service_pop when the ring is drained
+ */
+int service_get_fd(void);
+
+/**
+ * @brief      service pop an event
+ * @param[out] *event pointer to an event buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 pop failed
+ *             - 2 no event
+ * @note       only one consumer thread can pop events
+ */
+uint8_t service_pop(multi_button_event_t *event);
+
+/**
+ * @brief      service get the dropped event count
+ * @param[out] *cnt pointer to a count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       none
+ */
+uint8_t service_get_overflow(uint32_t *cnt);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,233 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ * @file      client.c
+ * @brief     client source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "client.h"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief     receive the bytes without blocking
+ * @param[in] *handle pointer to a client handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed or the server is gone
+ *            - 2 no data
+ * @note      none
+ */
+static uint8_t a_client_recv(client_handle_t *handle)
+{
+    ssize_t res;
+    
+    /* move the partial record to the front */
+    if (handle->start != 0)
+    {
+        memmove(handle->buf, handle->buf + handle->start, handle->end - handle->start);
+        handle->end -= handle->start;
+        handle->start = 0;
+    }
+    
+    while (1)
+    {
+        res = recv(handle->fd, handle->buf + handle->end, CLIENT_BUFFER_SIZE - handle->end, MSG_DONTWAIT);
+        if (res > 0)
+        {
+            handle->end += (uint32_t)res;
+            
+            return 0;
+        }
+        if (res == 0)
+        {
+            return 1;
+        }
+        if (errno == EINTR)
+        {
+            continue;
+        }
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+        {
+            return 2;
+        }
+        
+        return 1;
+    }
+}
+
+/**
+ * @brief     client open
+ * @param[in] *handle pointer to a client handle structure
+ * @param[in] *path pointer to a unix socket path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 4 path is too long
+ * @note      none
+ */
+uint8_t client_open(client_handle_t *handle, const char *path)
+{
+    struct sockaddr_un addr;
+    
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        return 4;
+    }
+    memset(handle, 0, sizeof(client_handle_t));
+    handle->fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (handle->fd < 0)
+    {
+        return 1;
+    }
+    memset(&addr, 0, sizeof(struct sockaddr_un));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    if (connect(handle->fd, (struct sockaddr *)&addr, sizeof(struct sockaddr_un)) != 0)
+    {
+        (void)close(handle->fd);
+        handle->fd = -1;
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     client close
+ * @param[in] *handle pointer to a client handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      none
+ */
+uint8_t client_close(client_handle_t *handle)
+{
+    if (handle->fd < 0)
+    {
+        return 1;
+    }
+    (void)close(handle->fd);
+    handle->fd = -1;
+    
+    return 0;
+}
+
+/**
+ * @brief     client get the pollable file descriptor
+ * @param[in] *handle pointer to a client handle structure
+ * @return    file descriptor, -1 means closed
+ * @note      call client_read until it returns 2 after the fd is readable,
+ *            the buffered records do not make the fd readable
+ */
+int client_get_fd(client_handle_t *handle)
+{
+    return handle->fd;
+}
+
+/**
+ * @brief      client read a record
+ * @param[in]  *handle pointer to a client handle structure
+ * @param[out] *record pointer to a record buffer
+ * @param[in]  timeout_ms wait time in ms, 0 means no wait and -1 means forever
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed or the server is gone
+ *             - 2 no record
+ * @note       none
+ */
+uint8_t client_read(client_handle_t *handle, protocol_record_t *record, int timeout_ms)
+{
+    uint8_t res;
+    struct pollfd fds;
+    
+    if (handle->fd < 0)
+    {
+        return 1;
+    }
+    
+    /* fill the buffer until a whole record is received */
+    while (handle->end - handle->start < PROTOCOL_RECORD_SIZE)
+    {
+        res = a_client_recv(handle);
+        if (res == 1)
+        {
+            return 1;
+        }
+        if (res == 0)
+        {
+            continue;
+        }
+        if (timeout_ms == 0)
+        {
+            return 2;
+        }
+        fds.fd = handle->fd;
+        fds.events = POLLIN;
+        fds.revents = 0;
+        if (poll(&fds, 1, timeout_ms) == 0)
+        {
+            return 2;
+        }
+    }
+    memcpy(record, handle->buf + handle->start, PROTOCOL_RECORD_SIZE);
+    handle->start += PROTOCOL_RECORD_SIZE;
+    
+    /* count the gaps */
+    if ((handle->seq_valid != 0) && (record->seq - handle->seq > 1))
+    {
+        handle->lost += record->seq - handle->seq - 1;
+    }
+    handle->seq = record->seq;
+    handle->seq_valid = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief      client get the lost record count
+ * @param[in]  *handle pointer to a client handle structure
+ * @param[out] *cnt pointer to a count buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the server drops the oldest records of a slow client, the gaps of seq are counted
+ */
+uint8_t client_get_lost(client_handle_t *handle, uint32_t *cnt)
+{
+    *cnt = handle->lost;
+    
+    return 0;
+}
@@ -0,0 +1,208 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ * @file      clock.c
+ * @brief     clock source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "clock.h"
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief global var definition
+ */
+static clock_source_t gs_source = CLOCK_SOURCE_MONOTONIC;        /**< timestamp source */
+
+/**
+ * @brief clock name table definition
+ */
+static const char *const gs_name[3] = {"monotonic", "raw", "realtime"};        /**< source names */
+
+/**
+ * @brief     get the posix clock id
+ * @param[in] source clock source
+ * @return    clock id
+ * @note      none
+ */
+static clockid_t a_clock_get_id(clock_source_t source)
+{
+    switch (source)
+    {
+        case CLOCK_SOURCE_MONOTONIC_RAW :
+        {
+            return CLOCK_MONOTONIC_RAW;
+        }
+        case CLOCK_SOURCE_REALTIME :
+        {
+            return CLOCK_REALTIME;
+        }
+        default :
+        {
+            return CLOCK_MONOTONIC;
+        }
+    }
+}
+
+/**
+ * @brief     clock set the timestamp source
+ * @param[in] source clock source
+ * @note      call it before the driver init, the default is CLOCK_SOURCE_MONOTONIC
+ */
+void clock_set_source(clock_source_t source)
+{
+    gs_source = source;
+}
+
+/**
+ * @brief  clock get the timestamp source
+ * @return clock source
+ * @note   none
+ */
+clock_source_t clock_get_source(void)
+{
+    return gs_source;
+}
+
+/**
+ * @brief      clock parse a source name
+ * @param[in]  *str pointer to a name, "monotonic", "raw" or "realtime"
+ * @param[out] *source pointer to a clock source buffer
+ * @return     status code
+ *             - 0 success
+ *             - 4 name is invalid
+ * @note       none
+ */
+uint8_t clock_parse(const char *str, clock_source_t *source)
+{
+    uint8_t i;
+    
+    for (i = 0; i < 3; i++)
+    {
+        if (strcmp(str, gs_name[i]) == 0)
+        {
+            *source = (clock_source_t)i;
+            
+            return 0;
+        }
+    }
+    
+    return 4;
+}
+
+/**
+ * @brief     clock get the source name
+ * @param[in] source clock source
+ * @return    pointer to the name
+ * @note      none
+ */
+const char *clock_get_name(clock_source_t source)
+{
+    if ((uint32_t)source > CLOCK_SOURCE_REALTIME)
+    {
+        return "unknown";
+    }
+    
+    return gs_name[source];
+}
+
+/**
+ * @brief      clock read the timestamp
+ * @param[out] *s pointer to a second buffer
+ * @param[out] *us pointer to a microsecond buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t clock_read(uint64_t *s, uint32_t *us)
+{
+    struct timespec ts;
+    
+    if (clock_gettime(a_clock_get_id(gs_source), &ts) != 0)
+    {
+        return 1;
+    }
+    *s = (uint64_t)ts.tv_sec;
+    *us = (uint32_t)(ts.tv_nsec / 1000);
+    
+    return 0;
+}
+
+/**
+ * @brief      clock benchmark the read cost of a source
+ * @param[in]  source clock source
+ * @param[in]  times read times
+ * @param[out] *ns pointer to a read cost buffer in ns
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 4 times is 0
+ * @note       the loop is timed with CLOCK_MONOTONIC
+ */
+uint8_t clock_benchmark(clock_source_t source, uint32_t times, double *ns)
+{
+    uint32_t i;
+    clockid_t id;
+    struct timespec start;
+    struct timespec stop;
+    struct timespec ts;
+    
+    if (times == 0)
+    {
+        return 4;
+    }
+    id = a_clock_get_id(source);
+    
+    /* warm up the vdso page */
+    if (clock_gettime(id, &ts) != 0)
+    {
+        return 1;
+    }
+    
+    /* time the reads */
+    if (clock_gettime(CLOCK_MONOTONIC, &start) != 0)
+    {
+        return 1;
+    }
+    for (i = 0; i < times; i++)
+    {
+        (void)clock_gettime(id, &ts);
+    }
+    if (clock_gettime(CLOCK_MONOTONIC, &stop) != 0)
+    {
+        return 1;
+    }
+    *ns = ((double)(stop.tv_sec - start.tv_sec) * 1e9 +
+           (double)(stop.tv_nsec - start.tv_nsec)) / (double)times;
+    
+    return 0;
+}
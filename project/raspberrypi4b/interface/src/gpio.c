@@ -36,50 +36,58 @@
 
 #include "gpio.h"
 #include <gpiod.h>
+#include <string.h>
 
 /**
- * @brief gpio device name definition
- */
-#define GPIO_DEVICE_NAME "/dev/gpiochip0"        /**< gpio device name */
-
-/**
- * @brief gpio device line definition
+ * @brief global var definition
  */
-#define GPIO_DEVICE_LINE_ROW0        17        /**< gpio device line */
-#define GPIO_DEVICE_LINE_ROW1        27        /**< gpio device line */
-#define GPIO_DEVICE_LINE_ROW2        22        /**< gpio device line */
-#define GPIO_DEVICE_LINE_ROW3        5        /**< gpio device line */
-#define GPIO_DEVICE_LINE_COL0        6        /**< gpio device line */
-#define GPIO_DEVICE_LINE_COL1        13        /**< gpio device line */
-#define GPIO_DEVICE_LINE_COL2        19        /**< gpio device line */
-#define GPIO_DEVICE_LINE_COL3        26        /**< gpio device line */
+static pinmap_t gs_map;                                    /**< gpio pin map */
+static uint8_t gs_map_set = 0;                             /**< gpio pin map set flag */
+static struct gpiod_chip *gs_chip;                         /**< gpio chip handle */
+static struct gpiod_line_bulk gs_row_bulk;                 /**< gpio row lines handle */
+static struct gpiod_line_bulk gs_col_bulk;                 /**< gpio col lines handle */
+static int gs_row_value[PINMAP_MAX_LINE];                  /**< gpio row lines level */
 
 /**
- * @brief global var definition
+ * @brief     gpio matrix set the pin map
+ * @param[in] *map pointer to a pinmap structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      call it before gpio_matrix_init, the default 4x4 map is used if it is not called
  */
-static struct gpiod_chip *gs_chip;                         /**< gpio chip handle */
-static struct gpiod_line *gs_line_row0;                    /**< gpio line row0 handle */
-static struct gpiod_line *gs_line_row1;                    /**< gpio line row1 handle */
-static struct gpiod_line *gs_line_row2;                    /**< gpio line row2 handle */
-static struct gpiod_line *gs_line_row3;                    /**< gpio line row3 handle */
-static struct gpiod_line *gs_line_col0;                    /**< gpio line col0 handle */
-static struct gpiod_line *gs_line_col1;                    /**< gpio line col1 handle */
-static struct gpiod_line *gs_line_col2;                    /**< gpio line col2 handle */
-static struct gpiod_line *gs_line_col3;                    /**< gpio line col3 handle */
+uint8_t gpio_matrix_set_map(const pinmap_t *map)
+{
+    if (pinmap_check(map) != 0)
+    {
+        return 1;
+    }
+    memcpy(&gs_map, map, sizeof(pinmap_t));
+    gs_map_set = 1;
+    
+    return 0;
+}
 
 /**
  * @brief  gpio matrix init
  * @return status code
  *         - 0 success
  *         - 1 init failed
- * @note   none
+ * @note   all the rows are requested as one bulk and all the cols as another,
+ *         so a row select or a row read is one ioctl
  */
 uint8_t gpio_matrix_init(void)
 {
-    uint8_t res;
+    uint8_t i;
+    
+    /* use the default map */
+    if (gs_map_set == 0)
+    {
+        pinmap_init(&gs_map);
+    }
     
     /* open the gpio group */
-    gs_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
+    gs_chip = gpiod_chip_open(gs_map.chip);
     if (gs_chip == NULL)
     {
         perror("gpio: open failed.\n");
@@ -87,9 +95,8 @@ uint8_t gpio_matrix_init(void)
         return 1;
     }
     
-    /* get the gpio line */
-    gs_line_row0 = gpiod_chip_get_line(gs_chip, GPIO_DEVICE_LINE_ROW0);
-    if (gs_line_row0 == NULL) 
+    /* get the row lines */
+    if (gpiod_chip_get_lines(gs_chip, gs_map.row, gs_map.row_num, &gs_row_bulk) != 0)
     {
         perror("gpio: get line failed.\n");
         gpiod_chip_close(gs_chip);
@@ -97,120 +104,37 @@ uint8_t gpio_matrix_init(void)
         return 1;
     }
     
-    /* get the gpio line */
-    gs_line_row1 = gpiod_chip_get_line(gs_chip, GPIO_DEVICE_LINE_ROW1);
-    if (gs_line_row1 == NULL) 
-    {
-        perror("gpio: get line failed.\n");
-        gpiod_chip_close(gs_chip);
-
-        return 1;
-    }
-
-    /* get the gpio line */
-    gs_line_row2 = gpiod_chip_get_line(gs_chip, GPIO_DEVICE_LINE_ROW2);
-    if (gs_line_row2 == NULL) 
+    /* get the col lines */
+    if (gpiod_chip_get_lines(gs_chip, gs_map.col, gs_map.col_num, &gs_col_bulk) != 0)
     {
         perror("gpio: get line failed.\n");
         gpiod_chip_close(gs_chip);
 
         return 1;
     }
-
-    /* get the gpio line */
-    gs_line_row3 = gpiod_chip_get_line(gs_chip, GPIO_DEVICE_LINE_ROW3);
-    if (gs_line_row3 == NULL) 
-    {
-        perror("gpio: get line failed.\n");
-        gpiod_chip_close(gs_chip);
-
-        return 1;
-    }
-
-    /* get the gpio line */
-    gs_line_col0 = gpiod_chip_get_line(gs_chip, GPIO_DEVICE_LINE_COL0);
-    if (gs_line_col0 == NULL) 
-    {
-        perror("gpio: get line failed.\n");
-        gpiod_chip_close(gs_chip);
-
-        return 1;
-    }
-
-    /* get the gpio line */
-    gs_line_col1 = gpiod_chip_get_line(gs_chip, GPIO_DEVICE_LINE_COL1);
-    if (gs_line_col1 == NULL) 
-    {
-        perror("gpio: get line failed.\n");
-        gpiod_chip_close(gs_chip);
-
-        return 1;
-    }
-
-    /* get the gpio line */
-    gs_line_col2 = gpiod_chip_get_line(gs_chip, GPIO_DEVICE_LINE_COL2);
-    if (gs_line_col2 == NULL) 
-    {
-        perror("gpio: get line failed.\n");
-        gpiod_chip_close(gs_chip);
-
-        return 1;
-    }
-
-    /* get the gpio line */
-    gs_line_col3 = gpiod_chip_get_line(gs_chip, GPIO_DEVICE_LINE_COL3);
-    if (gs_line_col3 == NULL) 
-    {
-        perror("gpio: get line failed.\n");
-        gpiod_chip_close(gs_chip);
-
-        return 1;
-    }
-
-    /* set output */
-    if (gpiod_line_request_output(gs_line_row0, "gpio_output", GPIOD_LINE_ACTIVE_STATE_HIGH) != 0)
-    {
-        return 1;
-    }
-
-    /* set output */
-    if (gpiod_line_request_output(gs_line_row1, "gpio_output", GPIOD_LINE_ACTIVE_STATE_HIGH) != 0)
-    {
-        return 1;
-    }
-
-    /* set output */
-    if (gpiod_line_request_output(gs_line_row2, "gpio_output", GPIOD_LINE_ACTIVE_STATE_HIGH) != 0)
+    
+    /* all rows high */
+    for (i = 0; i < gs_map.row_num; i++)
     {
-        return 1;
+        gs_row_value[i] = 1;
     }
-
+    
     /* set output */
-    if (gpiod_line_request_output(gs_line_row3, "gpio_output", GPIOD_LINE_ACTIVE_STATE_HIGH) != 0)
-    {
-        return 1;
-    }
-
-    if (gpiod_line_request_input_flags(gs_line_col0, "gpio_input", GPIOD_LINE_REQUEST_FLAG_BIAS_PULL_UP) != 0)
+    if (gpiod_line_request_bulk_output(&gs_row_bulk, "gpio_output", gs_row_value) != 0)
     {
-        return 1;
-    }
+        perror("gpio: request output failed.\n");
+        gpiod_chip_close(gs_chip);
 
-    /* set input */
-    if (gpiod_line_request_input_flags(gs_line_col1, "gpio_input", GPIOD_LINE_REQUEST_FLAG_BIAS_PULL_UP) != 0) 
-    {
         return 1;
     }
-
+    
     /* set input */
-    if (gpiod_line_request_input_flags(gs_line_col2, "gpio_input", GPIOD_LINE_REQUEST_FLAG_BIAS_PULL_UP) != 0) 
+    if (gpiod_line_request_bulk_input_flags(&gs_col_bulk, "gpio_input", GPIOD_LINE_REQUEST_FLAG_BIAS_PULL_UP) != 0)
     {
-        return 1;
-    }
+        perror("gpio: request input failed.\n");
+        gpiod_line_release_bulk(&gs_row_bulk);
+        gpiod_chip_close(gs_chip);
 
-    /* set input */
-    if (gpiod_line_request_input_flags(gs_line_col3, "gpio_input", GPIOD_LINE_REQUEST_FLAG_BIAS_PULL_UP) != 0) 
-    {
         return 1;
     }
 
@@ -224,35 +148,48 @@ uint8_t gpio_matrix_init(void)
  * @return    status code
  *            - 0 success
  *            - 1 write failed
- * @note      none
+ * @note      the other rows keep their cached level
  */
 uint8_t gpio_matrix_write_row(uint16_t num, uint8_t level)
 {
-    struct gpiod_line *line;
-
-    if (num == 0)
-    {
-        line = gs_line_row0;
-    }
-    else if (num == 1)
+    if (num >= gs_map.row_num)
     {
-        line = gs_line_row1;
+        return 1;
     }
-    else if (num == 2)
+    
+    /* set the value */
+    gs_row_value[num] = (level != 0) ? 1 : 0;
+    if (gpiod_line_set_value(gpiod_line_bulk_get_line(&gs_row_bulk, num), gs_row_value[num]) != 0)
     {
-        line = gs_line_row2;
+        return 1;
     }
-    else if (num == 3)
+
+    return 0;
+}
+
+/**
+ * @brief     gpio select row
+ * @param[in] row selected row
+ * @return    status code
+ *            - 0 success
+ *            - 1 select failed
+ * @note      the row is set low and all the other rows high with one bulk set
+ */
+uint8_t gpio_matrix_select_row(uint16_t row)
+{
+    uint8_t i;
+    
+    if (row >= gs_map.row_num)
     {
-        line = gs_line_row3;
+        return 1;
     }
-    else
+    
+    /* set the values */
+    for (i = 0; i < gs_map.row_num; i++)
     {
-        return 1;
+        gs_row_value[i] = (i == row) ? 0 : 1;
     }
-
-    /* set the value */
-    if (gpiod_line_set_value(line, level) != 0)
+    if (gpiod_line_set_value_bulk(&gs_row_bulk, gs_row_value) != 0)
     {
         return 1;
     }
@@ -266,48 +203,41 @@ uint8_t gpio_matrix_write_row(uint16_t num, uint8_t level)
  * @return     status code
  *             - 0 success
  *             - 1 read failed
- * @note       none
+ * @note       all the cols are read with one bulk get
  */
 uint8_t gpio_matrix_read_row(uint32_t *col_array)
 {
-    int res;
-    uint8_t value;
-
-    *col_array = 0;
-
-    res = gpiod_line_get_value(gs_line_col0);
-    if (res < 0)
-    {
-        return 1;
-    }
-    value = (uint8_t)(res);
-    *col_array |= value << 0;
-
-    res = gpiod_line_get_value(gs_line_col1);
-    if (res < 0)
+    int value[PINMAP_MAX_LINE];
+    uint8_t i;
+    
+    /* get the values */
+    if (gpiod_line_get_value_bulk(&gs_col_bulk, value) != 0)
     {
         return 1;
     }
-    value = (uint8_t)(res);
-    *col_array |= value << 1;
-
-    res = gpiod_line_get_value(gs_line_col2);
-    if (res < 0)
+    *col_array = 0;
+    for (i = 0; i < gs_map.col_num; i++)
     {
-        return 1;
+        *col_array |= (uint32_t)(value[i] != 0) << i;
     }
-    value = (uint8_t)(res);
-    *col_array |= value << 2;
 
-    res = gpiod_line_get_value(gs_line_col3);
-    if (res < 0)
-    {
-        return 1;
-    }
-    value = (uint8_t)(res);
-    *col_array |= value << 3;
+    return 0;
+}
 
-     return 0;
+/**
+ * @brief      gpio matrix read row with the edge timestamps
+ * @param[out] *col_array pointer to a col array buffer
+ * @param[out] *timestamp_ns pointer to a col timestamp array
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the libgpiod v1 backend captures no edge, timestamp_ns is not changed
+ */
+uint8_t gpio_matrix_read_row_timestamp(uint32_t *col_array, uint64_t *timestamp_ns)
+{
+    (void)timestamp_ns;
+    
+    return gpio_matrix_read_row(col_array);
 }
 
 /**
@@ -319,6 +249,10 @@ uint8_t gpio_matrix_read_row(uint32_t *col_array)
  */
 uint8_t gpio_matrix_deinit(void)
 {
+    /* release the lines */
+    gpiod_line_release_bulk(&gs_col_bulk);
+    gpiod_line_release_bulk(&gs_row_bulk);
+    
     /* close the gpio */
     gpiod_chip_close(gs_chip);
     
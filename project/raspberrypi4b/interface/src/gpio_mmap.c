@@ -0,0 +1,369 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      gpio_mmap.c
+ * @brief     gpio register mmap source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "gpio.h"
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <sys/mman.h>
+
+/**
+ * @brief gpio mmap device definition
+ */
+#define GPIO_MMAP_DEVICE             "/dev/gpiomem"        /**< gpio register device */
+#define GPIO_MMAP_CHIP_PREFIX        "/dev/gpiochip"       /**< gpio chip prefix replaced by the register device */
+#define GPIO_MMAP_SIZE               4096                  /**< mapped register block size */
+#define GPIO_MMAP_MAX_PIN            58                    /**< bcm2711 gpio number */
+
+/**
+ * @brief gpio bcm2711 register definition
+ */
+#define GPIO_REG_GPFSEL0             (0x00 / 4)            /**< function select 0, 3 bits per pin */
+#define GPIO_REG_GPSET0              (0x1C / 4)            /**< output set 0 */
+#define GPIO_REG_GPCLR0              (0x28 / 4)            /**< output clear 0 */
+#define GPIO_REG_GPLEV0              (0x34 / 4)            /**< pin level 0 */
+#define GPIO_REG_PUP_PDN0            (0xE4 / 4)            /**< pull up down control 0, 2 bits per pin */
+
+/**
+ * @brief gpio register value definition
+ */
+#define GPIO_FSEL_INPUT              0x0                   /**< input function */
+#define GPIO_FSEL_OUTPUT             0x1                   /**< output function */
+#define GPIO_PULL_UP                 0x1                   /**< pull up */
+
+/**
+ * @brief gpio register barrier definition
+ * @note  the registers are device memory, dmb sy orders the accesses at the outer domain
+ */
+#if defined(__aarch64__) || defined(__arm__)
+    #define GPIO_MMAP_BARRIER()      __asm__ volatile("dmb sy" ::: "memory")
+#else
+    #define GPIO_MMAP_BARRIER()      atomic_thread_fence(memory_order_seq_cst)
+#endif
+
+/**
+ * @brief global var definition
+ */
+static pinmap_t gs_map;                                    /**< gpio pin map */
+static uint8_t gs_map_set = 0;                             /**< gpio pin map set flag */
+static volatile uint32_t *gs_reg = NULL;                   /**< gpio register block */
+static uint32_t gs_row_mask[2];                            /**< all row bits of each bank */
+
+/**
+ * @brief     gpio set the function of a pin
+ * @param[in] pin gpio pin
+ * @param[in] fsel pin function
+ * @note      read modify write, the other users of the bank must not run at the same time
+ */
+static void a_gpio_set_function(unsigned int pin, uint32_t fsel)
+{
+    volatile uint32_t *reg;
+    uint32_t shift;
+    
+    reg = &gs_reg[GPIO_REG_GPFSEL0 + pin / 10];
+    shift = (pin % 10) * 3;
+    *reg = (*reg & ~((uint32_t)0x7 << shift)) | (fsel << shift);
+}
+
+/**
+ * @brief     gpio set the pull of a pin
+ * @param[in] pin gpio pin
+ * @param[in] pull pin pull
+ * @note      read modify write, the other users of the bank must not run at the same time
+ */
+static void a_gpio_set_pull(unsigned int pin, uint32_t pull)
+{
+    volatile uint32_t *reg;
+    uint32_t shift;
+    
+    reg = &gs_reg[GPIO_REG_PUP_PDN0 + pin / 16];
+    shift = (pin % 16) * 2;
+    *reg = (*reg & ~((uint32_t)0x3 << shift)) | (pull << shift);
+}
+
+/**
+ * @brief     gpio matrix set the pin map
+ * @param[in] *map pointer to a pinmap structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      call it before gpio_matrix_init, the default 4x4 map is used if it is not called
+ */
+uint8_t gpio_matrix_set_map(const pinmap_t *map)
+{
+    if (pinmap_check(map) != 0)
+    {
+        return 1;
+    }
+    memcpy(&gs_map, map, sizeof(pinmap_t));
+    gs_map_set = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  gpio matrix init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   the chip path of the map is mapped as the register block, a /dev/gpiochip path
+ *         is replaced by /dev/gpiomem, a file with 4096 bytes works as a fake register page
+ */
+uint8_t gpio_matrix_init(void)
+{
+    int fd;
+    void *addr;
+    const char *path;
+    uint8_t i;
+    
+    /* use the default map */
+    if (gs_map_set == 0)
+    {
+        pinmap_init(&gs_map);
+    }
+    
+    /* check the pins */
+    for (i = 0; i < gs_map.row_num; i++)
+    {
+        if (gs_map.row[i] >= GPIO_MMAP_MAX_PIN)
+        {
+            return 1;
+        }
+    }
+    for (i = 0; i < gs_map.col_num; i++)
+    {
+        if (gs_map.col[i] >= GPIO_MMAP_MAX_PIN)
+        {
+            return 1;
+        }
+    }
+    
+    /* map the register block */
+    path = gs_map.chip;
+    if (strncmp(path, GPIO_MMAP_CHIP_PREFIX, strlen(GPIO_MMAP_CHIP_PREFIX)) == 0)
+    {
+        path = GPIO_MMAP_DEVICE;
+    }
+    fd = open(path, O_RDWR | O_SYNC | O_CLOEXEC);
+    if (fd < 0)
+    {
+        perror("gpio: open failed.\n");
+
+        return 1;
+    }
+    addr = mmap(NULL, GPIO_MMAP_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED)
+    {
+        perror("gpio: mmap failed.\n");
+
+        return 1;
+    }
+    gs_reg = (volatile uint32_t *)addr;
+    
+    /* set all rows high before they drive */
+    gs_row_mask[0] = 0;
+    gs_row_mask[1] = 0;
+    for (i = 0; i < gs_map.row_num; i++)
+    {
+        gs_row_mask[gs_map.row[i] / 32] |= (uint32_t)1 << (gs_map.row[i] % 32);
+    }
+    gs_reg[GPIO_REG_GPSET0] = gs_row_mask[0];
+    gs_reg[GPIO_REG_GPSET0 + 1] = gs_row_mask[1];
+    GPIO_MMAP_BARRIER();
+    
+    /* set output */
+    for (i = 0; i < gs_map.row_num; i++)
+    {
+        a_gpio_set_function(gs_map.row[i], GPIO_FSEL_OUTPUT);
+    }
+    
+    /* set input with pull up */
+    for (i = 0; i < gs_map.col_num; i++)
+    {
+        a_gpio_set_function(gs_map.col[i], GPIO_FSEL_INPUT);
+        a_gpio_set_pull(gs_map.col[i], GPIO_PULL_UP);
+    }
+    GPIO_MMAP_BARRIER();
+
+    return 0;
+}
+
+/**
+ * @brief     gpio write row
+ * @param[in] num row number
+ * @param[in] level set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      one register write
+ */
+uint8_t gpio_matrix_write_row(uint16_t num, uint8_t level)
+{
+    unsigned int pin;
+    
+    if (num >= gs_map.row_num)
+    {
+        return 1;
+    }
+    
+    /* set or clear the pin */
+    pin = gs_map.row[num];
+    GPIO_MMAP_BARRIER();
+    if (level != 0)
+    {
+        gs_reg[GPIO_REG_GPSET0 + pin / 32] = (uint32_t)1 << (pin % 32);
+    }
+    else
+    {
+        gs_reg[GPIO_REG_GPCLR0 + pin / 32] = (uint32_t)1 << (pin % 32);
+    }
+    GPIO_MMAP_BARRIER();
+
+    return 0;
+}
+
+/**
+ * @brief     gpio select row
+ * @param[in] row selected row
+ * @return    status code
+ *            - 0 success
+ *            - 1 select failed
+ * @note      the other rows are set high before the row is cleared low,
+ *            so two rows never drive low together
+ */
+uint8_t gpio_matrix_select_row(uint16_t row)
+{
+    unsigned int pin;
+    uint32_t bit;
+    uint32_t bank;
+    
+    if (row >= gs_map.row_num)
+    {
+        return 1;
+    }
+    
+    /* set the other rows high and the row low */
+    pin = gs_map.row[row];
+    bank = pin / 32;
+    bit = (uint32_t)1 << (pin % 32);
+    GPIO_MMAP_BARRIER();
+    gs_reg[GPIO_REG_GPSET0] = gs_row_mask[0] & ((bank == 0) ? ~bit : 0xFFFFFFFFU);
+    gs_reg[GPIO_REG_GPSET0 + 1] = gs_row_mask[1] & ((bank == 1) ? ~bit : 0xFFFFFFFFU);
+    GPIO_MMAP_BARRIER();
+    gs_reg[GPIO_REG_GPCLR0 + bank] = bit;
+    GPIO_MMAP_BARRIER();
+
+    return 0;
+}
+
+/**
+ * @brief      gpio matrix read row
+ * @param[out] *col_array pointer to a col array buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       both level registers are read once
+ */
+uint8_t gpio_matrix_read_row(uint32_t *col_array)
+{
+    uint32_t level[2];
+    uint8_t i;
+    
+    /* read the levels */
+    GPIO_MMAP_BARRIER();
+    level[0] = gs_reg[GPIO_REG_GPLEV0];
+    level[1] = gs_reg[GPIO_REG_GPLEV0 + 1];
+    GPIO_MMAP_BARRIER();
+    
+    /* gather the cols */
+    *col_array = 0;
+    for (i = 0; i < gs_map.col_num; i++)
+    {
+        *col_array |= ((level[gs_map.col[i] / 32] >> (gs_map.col[i] % 32)) & 0x1) << i;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      gpio matrix read row with the edge timestamps
+ * @param[out] *col_array pointer to a col array buffer
+ * @param[out] *timestamp_ns pointer to a col timestamp array
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the register backend captures no edge, timestamp_ns is not changed
+ */
+uint8_t gpio_matrix_read_row_timestamp(uint32_t *col_array, uint64_t *timestamp_ns)
+{
+    (void)timestamp_ns;
+    
+    return gpio_matrix_read_row(col_array);
+}
+
+/**
+ * @brief  gpio matrix deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   the rows are set back to input
+ */
+uint8_t gpio_matrix_deinit(void)
+{
+    uint8_t i;
+    
+    if (gs_reg == NULL)
+    {
+        return 1;
+    }
+    
+    /* release the rows */
+    for (i = 0; i < gs_map.row_num; i++)
+    {
+        a_gpio_set_function(gs_map.row[i], GPIO_FSEL_INPUT);
+    }
+    GPIO_MMAP_BARRIER();
+    
+    /* unmap the register block */
+    if (munmap((void *)gs_reg, GPIO_MMAP_SIZE) != 0)
+    {
+        return 1;
+    }
+    gs_reg = NULL;
+    
+    return 0;
+}
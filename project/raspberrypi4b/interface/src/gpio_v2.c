@@ -0,0 +1,395 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      gpio_v2.c
+ * @brief     gpio libgpiod v2 source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "gpio.h"
+#include "clock.h"
+#include <gpiod.h>
+#include <string.h>
+
+/**
+ * @brief gpio edge event buffer size definition
+ */
+#define GPIO_EVENT_BUFFER_SIZE        64       /**< edge events drained per read */
+
+/**
+ * @brief global var definition
+ */
+static pinmap_t gs_map;                                             /**< gpio pin map */
+static uint8_t gs_map_set = 0;                                      /**< gpio pin map set flag */
+static struct gpiod_chip *gs_chip;                                  /**< gpio chip handle */
+static struct gpiod_line_request *gs_row_request;                   /**< gpio row lines request */
+static struct gpiod_line_request *gs_col_request;                   /**< gpio col lines request */
+static struct gpiod_edge_event_buffer *gs_event_buffer;             /**< gpio edge event buffer */
+static enum gpiod_line_value gs_row_value[PINMAP_MAX_LINE];         /**< gpio row lines level */
+
+/**
+ * @brief     request the lines
+ * @param[in] *offset pointer to a line offset table
+ * @param[in] num line number
+ * @param[in] *settings pointer to the line settings
+ * @param[in] *consumer pointer to a consumer name
+ * @return    pointer to the line request, NULL if failed
+ * @note      none
+ */
+static struct gpiod_line_request *a_gpio_request_lines(const unsigned int *offset, size_t num,
+                                                       struct gpiod_line_settings *settings,
+                                                       const char *consumer)
+{
+    struct gpiod_line_config *line_config;
+    struct gpiod_request_config *request_config;
+    struct gpiod_line_request *request;
+    
+    request = NULL;
+    line_config = gpiod_line_config_new();
+    request_config = gpiod_request_config_new();
+    if ((line_config != NULL) && (request_config != NULL))
+    {
+        gpiod_request_config_set_consumer(request_config, consumer);
+        gpiod_request_config_set_event_buffer_size(request_config, GPIO_EVENT_BUFFER_SIZE);
+        if (gpiod_line_config_add_line_settings(line_config, offset, num, settings) == 0)
+        {
+            request = gpiod_chip_request_lines(gs_chip, request_config, line_config);
+        }
+    }
+    gpiod_request_config_free(request_config);
+    gpiod_line_config_free(line_config);
+    
+    return request;
+}
+
+/**
+ * @brief      drain the col edge events
+ * @param[out] *timestamp_ns pointer to a col timestamp array, NULL to drop the events
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_gpio_drain_events(uint64_t *timestamp_ns)
+{
+    int res;
+    int i;
+    uint8_t j;
+    unsigned int offset;
+    struct gpiod_edge_event *event;
+    
+    while (1)
+    {
+        /* check the pending events without blocking */
+        res = gpiod_line_request_wait_edge_events(gs_col_request, 0);
+        if (res < 0)
+        {
+            return 1;
+        }
+        if (res == 0)
+        {
+            return 0;
+        }
+        
+        /* read a batch of events */
+        res = gpiod_line_request_read_edge_events(gs_col_request, gs_event_buffer, GPIO_EVENT_BUFFER_SIZE);
+        if (res < 0)
+        {
+            return 1;
+        }
+        if (timestamp_ns == NULL)
+        {
+            continue;
+        }
+        for (i = 0; i < res; i++)
+        {
+            event = gpiod_edge_event_buffer_get_event(gs_event_buffer, (unsigned long)i);
+            offset = gpiod_edge_event_get_line_offset(event);
+            for (j = 0; j < gs_map.col_num; j++)
+            {
+                /* keep the first edge, the later ones are bounces */
+                if ((gs_map.col[j] == offset) && (timestamp_ns[j] == 0))
+                {
+                    timestamp_ns[j] = gpiod_edge_event_get_timestamp_ns(event);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief     gpio matrix set the pin map
+ * @param[in] *map pointer to a pinmap structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      call it before gpio_matrix_init, the default 4x4 map is used if it is not called
+ */
+uint8_t gpio_matrix_set_map(const pinmap_t *map)
+{
+    if (pinmap_check(map) != 0)
+    {
+        return 1;
+    }
+    memcpy(&gs_map, map, sizeof(pinmap_t));
+    gs_map_set = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  gpio matrix init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   all the rows are requested as one line request and all the cols as another,
+ *         the cols detect both edges with the clock of the timestamp_read
+ */
+uint8_t gpio_matrix_init(void)
+{
+    uint8_t i;
+    struct gpiod_line_settings *settings;
+    
+    /* use the default map */
+    if (gs_map_set == 0)
+    {
+        pinmap_init(&gs_map);
+    }
+    
+    /* open the gpio group */
+    gs_chip = gpiod_chip_open(gs_map.chip);
+    if (gs_chip == NULL)
+    {
+        perror("gpio: open failed.\n");
+
+        return 1;
+    }
+    
+    /* new the line settings */
+    settings = gpiod_line_settings_new();
+    if (settings == NULL)
+    {
+        perror("gpio: new settings failed.\n");
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+    
+    /* set output with all rows high */
+    gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_OUTPUT);
+    gpiod_line_settings_set_output_value(settings, GPIOD_LINE_VALUE_ACTIVE);
+    gs_row_request = a_gpio_request_lines(gs_map.row, gs_map.row_num, settings, "gpio_output");
+    if (gs_row_request == NULL)
+    {
+        perror("gpio: request output failed.\n");
+        gpiod_line_settings_free(settings);
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+    for (i = 0; i < gs_map.row_num; i++)
+    {
+        gs_row_value[i] = GPIOD_LINE_VALUE_ACTIVE;
+    }
+    
+    /* set input with both edges */
+    gpiod_line_settings_reset(settings);
+    gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_INPUT);
+    gpiod_line_settings_set_bias(settings, GPIOD_LINE_BIAS_PULL_UP);
+    gpiod_line_settings_set_edge_detection(settings, GPIOD_LINE_EDGE_BOTH);
+    if (clock_get_source() == CLOCK_SOURCE_REALTIME)
+    {
+        gpiod_line_settings_set_event_clock(settings, GPIOD_LINE_CLOCK_REALTIME);
+    }
+    else
+    {
+        gpiod_line_settings_set_event_clock(settings, GPIOD_LINE_CLOCK_MONOTONIC);
+    }
+    gs_col_request = a_gpio_request_lines(gs_map.col, gs_map.col_num, settings, "gpio_input");
+    gpiod_line_settings_free(settings);
+    if (gs_col_request == NULL)
+    {
+        perror("gpio: request input failed.\n");
+        gpiod_line_request_release(gs_row_request);
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+    
+    /* new the event buffer */
+    gs_event_buffer = gpiod_edge_event_buffer_new(GPIO_EVENT_BUFFER_SIZE);
+    if (gs_event_buffer == NULL)
+    {
+        perror("gpio: new event buffer failed.\n");
+        gpiod_line_request_release(gs_col_request);
+        gpiod_line_request_release(gs_row_request);
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     gpio write row
+ * @param[in] num row number
+ * @param[in] level set level
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the other rows keep their cached level
+ */
+uint8_t gpio_matrix_write_row(uint16_t num, uint8_t level)
+{
+    if (num >= gs_map.row_num)
+    {
+        return 1;
+    }
+    
+    /* set the value */
+    gs_row_value[num] = (level != 0) ? GPIOD_LINE_VALUE_ACTIVE : GPIOD_LINE_VALUE_INACTIVE;
+    if (gpiod_line_request_set_value(gs_row_request, gs_map.row[num], gs_row_value[num]) != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     gpio select row
+ * @param[in] row selected row
+ * @return    status code
+ *            - 0 success
+ *            - 1 select failed
+ * @note      the row is set low and all the other rows high with one set,
+ *            the edges captured before the select belong to the last row and are dropped
+ */
+uint8_t gpio_matrix_select_row(uint16_t row)
+{
+    uint8_t i;
+    
+    if (row >= gs_map.row_num)
+    {
+        return 1;
+    }
+    
+    /* drop the old edges */
+    if (a_gpio_drain_events(NULL) != 0)
+    {
+        return 1;
+    }
+    
+    /* set the values */
+    for (i = 0; i < gs_map.row_num; i++)
+    {
+        gs_row_value[i] = (i == row) ? GPIOD_LINE_VALUE_INACTIVE : GPIOD_LINE_VALUE_ACTIVE;
+    }
+    if (gpiod_line_request_set_values(gs_row_request, gs_row_value) != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      gpio matrix read row
+ * @param[out] *col_array pointer to a col array buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       all the cols are read with one get
+ */
+uint8_t gpio_matrix_read_row(uint32_t *col_array)
+{
+    enum gpiod_line_value value[PINMAP_MAX_LINE];
+    uint8_t i;
+    
+    /* get the values */
+    if (gpiod_line_request_get_values(gs_col_request, value) != 0)
+    {
+        return 1;
+    }
+    *col_array = 0;
+    for (i = 0; i < gs_map.col_num; i++)
+    {
+        *col_array |= (uint32_t)(value[i] == GPIOD_LINE_VALUE_ACTIVE) << i;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      gpio matrix read row with the edge timestamps
+ * @param[out] *col_array pointer to a col array buffer
+ * @param[out] *timestamp_ns pointer to a col timestamp array
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       timestamp_ns must be cleared to 0 before the call, the first edge of each col
+ *             captured since the row was selected is saved in ns, the other cols are not changed,
+ *             the kernel has no raw event clock so the edges are dropped with CLOCK_SOURCE_MONOTONIC_RAW
+ */
+uint8_t gpio_matrix_read_row_timestamp(uint32_t *col_array, uint64_t *timestamp_ns)
+{
+    /* drain the edges of this row */
+    if (a_gpio_drain_events((clock_get_source() == CLOCK_SOURCE_MONOTONIC_RAW) ?
+                            NULL : timestamp_ns) != 0)
+    {
+        return 1;
+    }
+    
+    return gpio_matrix_read_row(col_array);
+}
+
+/**
+ * @brief  gpio matrix deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t gpio_matrix_deinit(void)
+{
+    /* free the event buffer */
+    gpiod_edge_event_buffer_free(gs_event_buffer);
+    
+    /* release the lines */
+    gpiod_line_request_release(gs_col_request);
+    gpiod_line_request_release(gs_row_request);
+    
+    /* close the gpio */
+    gpiod_chip_close(gs_chip);
+    
+    return 0;
+}
@@ -0,0 +1,243 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      pinmap.c
+ * @brief     pinmap source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "pinmap.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief pinmap default definition
+ */
+#define PINMAP_DEFAULT_CHIP        "/dev/gpiochip0"        /**< default gpio chip */
+
+/**
+ * @brief default line table definition
+ */
+static const unsigned int gs_default_row[4] = {17, 27, 22, 5};        /**< default row lines */
+static const unsigned int gs_default_col[4] = {6, 13, 19, 26};        /**< default col lines */
+
+/**
+ * @brief      pinmap init with the default 4x4 map
+ * @param[out] *map pointer to a pinmap structure
+ * @note       rows are GPIO17/27/22/5 and cols are GPIO6/13/19/26 of /dev/gpiochip0
+ */
+void pinmap_init(pinmap_t *map)
+{
+    memset(map, 0, sizeof(pinmap_t));
+    strncpy(map->chip, PINMAP_DEFAULT_CHIP, PINMAP_CHIP_SIZE - 1);
+    memcpy(map->row, gs_default_row, sizeof(gs_default_row));
+    memcpy(map->col, gs_default_col, sizeof(gs_default_col));
+    map->row_num = 4;
+    map->col_num = 4;
+}
+
+/**
+ * @brief      pinmap parse a line list
+ * @param[in]  *str pointer to a list such as "17,27,22,5"
+ * @param[out] *line pointer to a line offset array with PINMAP_MAX_LINE entries
+ * @param[out] *num pointer to a line number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 4 list is invalid
+ * @note       the offsets are separated with commas or spaces
+ */
+uint8_t pinmap_parse_list(const char *str, unsigned int *line, uint8_t *num)
+{
+    const char *p;
+    char *end;
+    unsigned long value;
+    uint8_t n;
+    
+    n = 0;
+    p = str;
+    while (1)
+    {
+        /* skip the separators */
+        while ((*p == ',') || (*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == '\n'))
+        {
+            p++;
+        }
+        if (*p == '\0')
+        {
+            break;
+        }
+        
+        /* parse the offset */
+        value = strtoul(p, &end, 10);
+        if ((end == p) || (value > 0xFFFFU))
+        {
+            return 4;
+        }
+        if (n >= PINMAP_MAX_LINE)
+        {
+            return 4;
+        }
+        line[n] = (unsigned int)value;
+        n++;
+        p = end;
+    }
+    if (n == 0)
+    {
+        return 4;
+    }
+    *num = n;
+    
+    return 0;
+}
+
+/**
+ * @brief         pinmap load a map file
+ * @param[in,out] *map pointer to a pinmap structure
+ * @param[in]     *path pointer to a map file path
+ * @return        status code
+ *                - 0 success
+ *                - 1 open failed
+ *                - 4 file is invalid
+ * @note          each line is "chip <path>", "row <offsets>" or "col <offsets>",
+ *                '#' starts a comment and the keys not in the file are not changed
+ */
+uint8_t pinmap_load(pinmap_t *map, const char *path)
+{
+    FILE *fp;
+    char buf[256];
+    char *key;
+    char *value;
+    char *p;
+    uint8_t res;
+    
+    fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        return 1;
+    }
+    res = 0;
+    while ((res == 0) && (fgets(buf, sizeof(buf), fp) != NULL))
+    {
+        /* cut the comment */
+        p = strchr(buf, '#');
+        if (p != NULL)
+        {
+            *p = '\0';
+        }
+        
+        /* split the key and the value */
+        key = buf + strspn(buf, " \t\r\n");
+        if (*key == '\0')
+        {
+            continue;
+        }
+        value = key + strcspn(key, " \t\r\n");
+        if (*value != '\0')
+        {
+            *value = '\0';
+            value++;
+        }
+        
+        /* set the item */
+        if (strcmp(key, "chip") == 0)
+        {
+            value += strspn(value, " \t");
+            value[strcspn(value, " \t\r\n")] = '\0';
+            if ((*value == '\0') || (strlen(value) >= PINMAP_CHIP_SIZE))
+            {
+                res = 4;
+            }
+            else
+            {
+                strcpy(map->chip, value);
+            }
+        }
+        else if (strcmp(key, "row") == 0)
+        {
+            res = pinmap_parse_list(value, map->row, &map->row_num);
+        }
+        else if (strcmp(key, "col") == 0)
+        {
+            res = pinmap_parse_list(value, map->col, &map->col_num);
+        }
+        else
+        {
+            res = 4;
+        }
+    }
+    (void)fclose(fp);
+    
+    return res;
+}
+
+/**
+ * @brief     pinmap check
+ * @param[in] *map pointer to a pinmap structure
+ * @return    status code
+ *            - 0 success
+ *            - 4 no row or col
+ *            - 5 line is used twice
+ * @note      none
+ */
+uint8_t pinmap_check(const pinmap_t *map)
+{
+    unsigned int line[PINMAP_MAX_LINE * 2];
+    uint8_t num;
+    uint8_t i;
+    uint8_t j;
+    
+    if ((map->row_num == 0) || (map->col_num == 0) ||
+        (map->row_num > PINMAP_MAX_LINE) || (map->col_num > PINMAP_MAX_LINE))
+    {
+        return 4;
+    }
+    num = 0;
+    for (i = 0; i < map->row_num; i++)
+    {
+        line[num++] = map->row[i];
+    }
+    for (i = 0; i < map->col_num; i++)
+    {
+        line[num++] = map->col[i];
+    }
+    for (i = 0; i < num; i++)
+    {
+        for (j = i + 1; j < num; j++)
+        {
+            if (line[i] == line[j])
+            {
+                return 5;
+            }
+        }
+    }
+    
+    return 0;
+}
@@ -0,0 +1,290 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scan.c
+ * @brief     scan source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+#include "scan.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <errno.h>
+#include <string.h>
+
+/**
+ * @brief global var definition
+ */
+static pthread_t gs_thread;                                     /**< scan thread handle */
+static pthread_mutex_t gs_mutex = PTHREAD_MUTEX_INITIALIZER;    /**< stat mutex */
+static atomic_int gs_running;                                   /**< scan thread running flag */
+static uint8_t gs_started;                                      /**< scan started flag */
+static uint8_t gs_locked;                                       /**< memory locked flag */
+static int64_t gs_period_ns;                                    /**< scan period in ns */
+static void (*gs_process)(void *arg);                           /**< process function */
+static void *gs_arg;                                            /**< process argument */
+static scan_stat_t gs_stat;                                     /**< period jitter stat */
+static uint64_t gs_jitter_sum;                                  /**< jitter sum in ns */
+
+/**
+ * @brief     add ns to a timespec
+ * @param[in] *t pointer to a timespec structure
+ * @param[in] ns added ns
+ * @note      none
+ */
+static void a_scan_timespec_add(struct timespec *t, int64_t ns)
+{
+    ns += t->tv_nsec;
+    t->tv_sec += ns / 1000000000L;
+    t->tv_nsec = ns % 1000000000L;
+}
+
+/**
+ * @brief     get the ns from a timespec to another
+ * @param[in] *from pointer to a timespec structure
+ * @param[in] *to pointer to a timespec structure
+ * @return    ns, negative if to is earlier than from
+ * @note      none
+ */
+static int64_t a_scan_timespec_diff(const struct timespec *from, const struct timespec *to)
+{
+    return (int64_t)(to->tv_sec - from->tv_sec) * 1000000000L + (to->tv_nsec - from->tv_nsec);
+}
+
+/**
+ * @brief     scan thread
+ * @param[in] *arg pointer to an argument
+ * @return    pointer to the result
+ * @note      none
+ */
+static void *a_scan_thread(void *arg)
+{
+    struct timespec next;
+    struct timespec now;
+    int64_t late;
+    uint32_t jitter;
+
+    (void)arg;
+    (void)clock_gettime(CLOCK_MONOTONIC, &next);                                        /* first deadline base */
+    while (atomic_load(&gs_running) != 0)
+    {
+        a_scan_timespec_add(&next, gs_period_ns);                                       /* next deadline */
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL) == EINTR)   /* sleep until the deadline */
+        {
+        }
+        (void)clock_gettime(CLOCK_MONOTONIC, &now);                                     /* get the wake up time */
+        late = a_scan_timespec_diff(&next, &now);                                       /* wake up latency */
+        gs_process(gs_arg);                                                             /* run the process */
+
+        jitter = (late < 0) ? 0 : ((late > UINT32_MAX) ? UINT32_MAX : (uint32_t)late);  /* clamp the latency */
+        (void)pthread_mutex_lock(&gs_mutex);                                            /* lock */
+        if ((gs_stat.cycle == 0) || (jitter < gs_stat.jitter_min_ns))                   /* check min */
+        {
+            gs_stat.jitter_min_ns = jitter;                                             /* set min */
+        }
+        if (jitter > gs_stat.jitter_max_ns)                                             /* check max */
+        {
+            gs_stat.jitter_max_ns = jitter;                                             /* set max */
+        }
+        gs_jitter_sum += jitter;                                                        /* sum */
+        gs_stat.cycle++;                                                                /* cycle++ */
+        gs_stat.jitter_avg_ns = (uint32_t)(gs_jitter_sum / gs_stat.cycle);              /* average */
+
+        (void)clock_gettime(CLOCK_MONOTONIC, &now);                                     /* get the finish time */
+        while (a_scan_timespec_diff(&next, &now) >= gs_period_ns)                       /* skip missed deadlines */
+        {
+            a_scan_timespec_add(&next, gs_period_ns);                                   /* next deadline */
+            gs_stat.overrun++;                                                          /* overrun++ */
+        }
+        (void)pthread_mutex_unlock(&gs_mutex);                                          /* unlock */
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief     scan start
+ * @param[in] *param pointer to a scan param structure
+ * @param[in] *process pointer to a process function address
+ * @param[in] *arg pointer to the process argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ *            - 4 set priority failed
+ *            - 5 set affinity failed
+ *            - 6 lock memory failed
+ * @note      the process runs on absolute deadlines of CLOCK_MONOTONIC,
+ *            so the processing time doesn't drift the period
+ */
+uint8_t scan_start(const scan_param_t *param, void (*process)(void *arg), void *arg)
+{
+    struct sched_param sp;
+    cpu_set_t cpus;
+
+    if ((gs_started != 0) || (param == NULL) || (process == NULL) || (param->period_us == 0))
+    {
+        return 1;
+    }
+
+    /* lock the memory before the thread runs */
+    if (param->lock_memory != 0)
+    {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        {
+            return 6;
+        }
+        gs_locked = 1;
+    }
+
+    /* init the runner */
+    gs_period_ns = (int64_t)param->period_us * 1000;
+    gs_process = process;
+    gs_arg = arg;
+    (void)scan_clear_stat();
+    atomic_store(&gs_running, 1);
+    if (pthread_create(&gs_thread, NULL, a_scan_thread, NULL) != 0)
+    {
+        atomic_store(&gs_running, 0);
+        if (gs_locked != 0)
+        {
+            (void)munlockall();
+            gs_locked = 0;
+        }
+
+        return 1;
+    }
+    gs_started = 1;
+
+    /* set the real time priority */
+    if (param->priority > 0)
+    {
+        memset(&sp, 0, sizeof(struct sched_param));
+        sp.sched_priority = param->priority;
+        if (pthread_setschedparam(gs_thread, SCHED_FIFO, &sp) != 0)
+        {
+            (void)scan_stop();
+
+            return 4;
+        }
+    }
+
+    /* set the cpu affinity */
+    if (param->cpu >= 0)
+    {
+        CPU_ZERO(&cpus);
+        CPU_SET(param->cpu, &cpus);
+        if (pthread_setaffinity_np(gs_thread, sizeof(cpu_set_t), &cpus) != 0)
+        {
+            (void)scan_stop();
+
+            return 5;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief  scan stop
+ * @return status code
+ *         - 0 success
+ *         - 1 stop failed
+ * @note   none
+ */
+uint8_t scan_stop(void)
+{
+    if (gs_started == 0)
+    {
+        return 1;
+    }
+
+    /* stop the thread */
+    atomic_store(&gs_running, 0);
+    if (pthread_join(gs_thread, NULL) != 0)
+    {
+        return 1;
+    }
+    gs_started = 0;
+
+    /* unlock the memory */
+    if (gs_locked != 0)
+    {
+        (void)munlockall();
+        gs_locked = 0;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      scan get the period jitter stat
+ * @param[out] *stat pointer to a scan stat structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       jitter is the wake up time minus the deadline
+ */
+uint8_t scan_get_stat(scan_stat_t *stat)
+{
+    if (stat == NULL)
+    {
+        return 1;
+    }
+
+    (void)pthread_mutex_lock(&gs_mutex);
+    *stat = gs_stat;
+    (void)pthread_mutex_unlock(&gs_mutex);
+
+    return 0;
+}
+
+/**
+ * @brief  scan clear the period jitter stat
+ * @return status code
+ *         - 0 success
+ *         - 1 clear failed
+ * @note   none
+ */
+uint8_t scan_clear_stat(void)
+{
+    (void)pthread_mutex_lock(&gs_mutex);
+    memset(&gs_stat, 0, sizeof(scan_stat_t));
+    gs_jitter_sum = 0;
+    (void)pthread_mutex_unlock(&gs_mutex);
+
+    return 0;
+}
@@ -0,0 +1,565 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ * @file      server.c
+ * @brief     server source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+#include "server.h"
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief server epoll event number definition
+ */
+#define SERVER_EVENT_NUMBER        64        /**< events handled per epoll wait */
+
+/**
+ * @brief server client structure definition
+ */
+typedef struct server_client_s
+{
+    int fd;                                          /**< client socket, -1 means free */
+    uint8_t wait_out;                                /**< wait for EPOLLOUT flag */
+    uint32_t head;                                   /**< next record to queue */
+    uint32_t tail;                                   /**< next record to send */
+    uint32_t offset;                                 /**< sent bytes of the tail record */
+    protocol_record_t ring[SERVER_RING_SIZE];        /**< record ring */
+} server_client_t;
+
+/**
+ * @brief global var definition
+ */
+static int gs_listen_fd = -1;                        /**< listen socket */
+static int gs_epoll_fd = -1;                         /**< epoll handle */
+static server_client_t *gs_client = NULL;            /**< client table */
+static uint16_t gs_max_client = 0;                   /**< client table size */
+static char gs_path[108];                            /**< socket path */
+static server_stat_t gs_stat;                        /**< server stat */
+
+/**
+ * @brief     set the epoll events of a client
+ * @param[in] *client pointer to a client structure
+ * @param[in] wait_out wait for EPOLLOUT
+ * @note      none
+ */
+static void a_server_wait_out(server_client_t *client, uint8_t wait_out)
+{
+    struct epoll_event ev;
+    
+    if (client->wait_out == wait_out)
+    {
+        return;
+    }
+    ev.events = EPOLLIN | (wait_out != 0 ? EPOLLOUT : 0);
+    ev.data.ptr = client;
+    (void)epoll_ctl(gs_epoll_fd, EPOLL_CTL_MOD, client->fd, &ev);
+    client->wait_out = wait_out;
+}
+
+/**
+ * @brief     close a client
+ * @param[in] *client pointer to a client structure
+ * @note      none
+ */
+static void a_server_close(server_client_t *client)
+{
+    (void)epoll_ctl(gs_epoll_fd, EPOLL_CTL_DEL, client->fd, NULL);
+    (void)close(client->fd);
+    client->fd = -1;
+    gs_stat.client--;
+}
+
+/**
+ * @brief     send the queued records of a client
+ * @param[in] *client pointer to a client structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ * @note      stops at a full socket buffer and waits for EPOLLOUT
+ */
+static uint8_t a_server_flush(server_client_t *client)
+{
+    ssize_t res;
+    uint32_t index;
+    uint32_t num;
+    uint32_t total;
+    
+    while (client->head != client->tail)
+    {
+        /* send the contiguous records up to the ring end */
+        index = client->tail % SERVER_RING_SIZE;
+        num = client->head - client->tail;
+        if (index + num > SERVER_RING_SIZE)
+        {
+            num = SERVER_RING_SIZE - index;
+        }
+        res = send(client->fd, (uint8_t *)&client->ring[index] + client->offset,
+                   num * PROTOCOL_RECORD_SIZE - client->offset, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (res < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                a_server_wait_out(client, 1);
+                
+                return 0;
+            }
+            
+            return 1;
+        }
+        
+        /* a record may be sent partly */
+        total = client->offset + (uint32_t)res;
+        client->tail += total / PROTOCOL_RECORD_SIZE;
+        client->offset = total % PROTOCOL_RECORD_SIZE;
+    }
+    a_server_wait_out(client, 0);
+    
+    return 0;
+}
+
+/**
+ * @brief     queue a record of a client
+ * @param[in] *client pointer to a client structure
+ * @param[in] *record pointer to a record structure
+ * @note      a full ring drops its oldest unsent record, the partly sent tail record is kept
+ */
+static void a_server_push(server_client_t *client, const protocol_record_t *record)
+{
+    if (client->head - client->tail == SERVER_RING_SIZE)
+    {
+        if (client->offset != 0)
+        {
+            /* move the partly sent record over the next one */
+            client->ring[(client->tail + 1) % SERVER_RING_SIZE] = client->ring[client->tail % SERVER_RING_SIZE];
+        }
+        client->tail++;
+        gs_stat.dropped++;
+    }
+    client->ring[client->head % SERVER_RING_SIZE] = *record;
+    client->head++;
+}
+
+/**
+ * @brief  accept the new clients
+ * @note   none
+ */
+static void a_server_accept(void)
+{
+    int fd;
+    int size;
+    uint16_t i;
+    struct epoll_event ev;
+    
+    while (1)
+    {
+        fd = accept4(gs_listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            return;
+        }
+        
+        /* find a free client */
+        for (i = 0; i < gs_max_client; i++)
+        {
+            if (gs_client[i].fd < 0)
+            {
+                break;
+            }
+        }
+        if (i == gs_max_client)
+        {
+            (void)close(fd);
+            gs_stat.rejected++;
+            
+            continue;
+        }
+        
+        /* keep the kernel queue short so the ring drops the oldest records */
+        size = SERVER_SOCKET_BUFFER;
+        (void)setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+        
+        /* watch the hang up */
+        ev.events = EPOLLIN;
+        ev.data.ptr = &gs_client[i];
+        if (epoll_ctl(gs_epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0)
+        {
+            (void)close(fd);
+            gs_stat.rejected++;
+            
+            continue;
+        }
+        gs_client[i].fd = fd;
+        gs_client[i].wait_out = 0;
+        gs_client[i].head = 0;
+        gs_client[i].tail = 0;
+        gs_client[i].offset = 0;
+        gs_stat.client++;
+        gs_stat.accepted++;
+    }
+}
+
+/**
+ * @brief     read and drop the client data
+ * @param[in] *client pointer to a client structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 client is closed
+ * @note      clients do not send anything, reading 0 bytes means the client is gone
+ */
+static uint8_t a_server_read(server_client_t *client)
+{
+    ssize_t res;
+    uint8_t buf[64];
+    
+    while (1)
+    {
+        res = recv(client->fd, buf, sizeof(buf), MSG_DONTWAIT);
+        if (res > 0)
+        {
+            continue;
+        }
+        if (res == 0)
+        {
+            return 1;
+        }
+        if (errno == EINTR)
+        {
+            continue;
+        }
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+        {
+            return 0;
+        }
+        
+        return 1;
+    }
+}
+
+/**
+ * @brief     server init
+ * @param[in] *path pointer to a unix socket path
+ * @param[in] max_client max client number
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 4 param is invalid
+ * @note      an existing socket file of the path is removed
+ */
+uint8_t server_init(const char *path, uint16_t max_client)
+{
+    uint16_t i;
+    struct sockaddr_un addr;
+    struct epoll_event ev;
+    
+    if (gs_epoll_fd >= 0)
+    {
+        perror("server: server is running.\n");
+        
+        return 1;
+    }
+    if ((max_client == 0) || (strlen(path) >= sizeof(addr.sun_path)))
+    {
+        return 4;
+    }
+    
+    /* alloc the client table */
+    gs_client = (server_client_t *)malloc(sizeof(server_client_t) * max_client);
+    if (gs_client == NULL)
+    {
+        perror("server: malloc failed.\n");
+        
+        return 1;
+    }
+    for (i = 0; i < max_client; i++)
+    {
+        gs_client[i].fd = -1;
+    }
+    gs_max_client = max_client;
+    memset(&gs_stat, 0, sizeof(server_stat_t));
+    
+    /* open the listen socket */
+    gs_listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (gs_listen_fd < 0)
+    {
+        perror("server: socket failed.\n");
+        
+        goto failed;
+    }
+    memset(&addr, 0, sizeof(struct sockaddr_un));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    (void)unlink(path);
+    if (bind(gs_listen_fd, (struct sockaddr *)&addr, sizeof(struct sockaddr_un)) != 0)
+    {
+        perror("server: bind failed.\n");
+        
+        goto failed;
+    }
+    if (listen(gs_listen_fd, SOMAXCONN) != 0)
+    {
+        perror("server: listen failed.\n");
+        
+        goto failed;
+    }
+    strcpy(gs_path, path);
+    
+    /* open the epoll */
+    gs_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (gs_epoll_fd < 0)
+    {
+        perror("server: epoll failed.\n");
+        
+        goto failed;
+    }
+    ev.events = EPOLLIN;
+    ev.data.ptr = NULL;
+    if (epoll_ctl(gs_epoll_fd, EPOLL_CTL_ADD, gs_listen_fd, &ev) != 0)
+    {
+        perror("server: epoll add failed.\n");
+        
+        goto failed;
+    }
+    
+    return 0;
+    
+    failed:
+    if (gs_epoll_fd >= 0)
+    {
+        (void)close(gs_epoll_fd);
+        gs_epoll_fd = -1;
+    }
+    if (gs_listen_fd >= 0)
+    {
+        (void)close(gs_listen_fd);
+        gs_listen_fd = -1;
+        (void)unlink(path);
+    }
+    free(gs_client);
+    gs_client = NULL;
+    
+    return 1;
+}
+
+/**
+ * @brief  server deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   all clients are closed and the socket file is removed
+ */
+uint8_t server_deinit(void)
+{
+    uint16_t i;
+    
+    if (gs_epoll_fd < 0)
+    {
+        return 1;
+    }
+    
+    /* close all clients */
+    for (i = 0; i < gs_max_client; i++)
+    {
+        if (gs_client[i].fd >= 0)
+        {
+            a_server_close(&gs_client[i]);
+        }
+    }
+    free(gs_client);
+    gs_client = NULL;
+    
+    /* close the sockets */
+    (void)close(gs_epoll_fd);
+    gs_epoll_fd = -1;
+    (void)close(gs_listen_fd);
+    gs_listen_fd = -1;
+    (void)unlink(gs_path);
+    
+    return 0;
+}
+
+/**
+ * @brief  server get the pollable file descriptor
+ * @return file descriptor, -1 means not initialized
+ * @note   the fd is the epoll fd and is readable while server_process has work
+ */
+int server_get_fd(void)
+{
+    return gs_epoll_fd;
+}
+
+/**
+ * @brief     server process the sockets
+ * @param[in] timeout_ms wait time in ms, 0 means no wait and -1 means forever
+ * @return    status code
+ *            - 0 success
+ *            - 1 process failed
+ * @note      accepts the new clients, flushes the client rings and closes the hung up clients
+ */
+uint8_t server_process(int timeout_ms)
+{
+    int i;
+    int num;
+    server_client_t *client;
+    struct epoll_event events[SERVER_EVENT_NUMBER];
+    
+    if (gs_epoll_fd < 0)
+    {
+        return 1;
+    }
+    
+    num = epoll_wait(gs_epoll_fd, events, SERVER_EVENT_NUMBER, timeout_ms);
+    if (num < 0)
+    {
+        return (errno == EINTR) ? 0 : 1;
+    }
+    for (i = 0; i < num; i++)
+    {
+        client = (server_client_t *)events[i].data.ptr;
+        if (client == NULL)
+        {
+            a_server_accept();
+            
+            continue;
+        }
+        if ((events[i].events & (EPOLLERR | EPOLLHUP)) != 0)
+        {
+            a_server_close(client);
+            
+            continue;
+        }
+        if (((events[i].events & EPOLLIN) != 0) && (a_server_read(client) != 0))
+        {
+            a_server_close(client);
+            
+            continue;
+        }
+        if (((events[i].events & EPOLLOUT) != 0) && (a_server_flush(client) != 0))
+        {
+            a_server_close(client);
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     server publish an event to all clients
+ * @param[in] *event pointer to an event structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 publish failed
+ * @note      the record is queued in each client ring and sent without blocking,
+ *            a full ring drops its oldest unsent record
+ */
+uint8_t server_publish(const multi_button_event_t *event)
+{
+    uint16_t i;
+    protocol_record_t record;
+    
+    if (gs_epoll_fd < 0)
+    {
+        return 1;
+    }
+    
+    /* encode the record */
+    record.seq = event->seq;
+    record.row = event->row;
+    record.col = event->col;
+    record.status = event->status;
+    record.times = event->times;
+    record.id = event->id;
+    record.s = event->t.s;
+    record.us = event->t.us;
+    record.duration_us = event->duration_us;
+    gs_stat.published++;
+    
+    /* queue and send */
+    for (i = 0; i < gs_max_client; i++)
+    {
+        if (gs_client[i].fd < 0)
+        {
+            continue;
+        }
+        a_server_push(&gs_client[i], &record);
+        
+        /* a client waiting for EPOLLOUT is flushed by server_process */
+        if ((gs_client[i].wait_out == 0) && (a_server_flush(&gs_client[i]) != 0))
+        {
+            a_server_close(&gs_client[i]);
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      server get the stat
+ * @param[out] *stat pointer to a stat structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       none
+ */
+uint8_t server_get_stat(server_stat_t *stat)
+{
+    uint16_t i;
+    
+    if (gs_epoll_fd < 0)
+    {
+        return 1;
+    }
+    
+    gs_stat.pending = 0;
+    for (i = 0; i < gs_max_client; i++)
+    {
+        if (gs_client[i].fd >= 0)
+        {
+            gs_stat.pending += gs_client[i].head - gs_client[i].tail;
+        }
+    }
+    memcpy(stat, &gs_stat, sizeof(server_stat_t));
+    
+    return 0;
+}
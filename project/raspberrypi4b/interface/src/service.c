@@ -0,0 +1,317 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      service.c
+ * @brief     service source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "service.h"
+#include "driver_multi_button_basic.h"
+#include "scan.h"
+#include <stdatomic.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+
+#if (MULTI_BUTTON_EVENT_RING_SIZE == 0)
+    #error "service needs MULTI_BUTTON_EVENT_RING_SIZE > 0"
+#endif
+
+/**
+ * @brief global var definition
+ */
+static multi_button_handle_t gs_handle;                    /**< multi_button handle */
+static multi_button_single_t gs_button[32 * 32];           /**< button storage up to 32x32 */
+static int gs_fd = -1;                                     /**< eventfd handle */
+
+/**
+ * @brief     service scan process
+ * @param[in] *arg pointer to an argument
+ * @note      none
+ */
+static void a_service_process(void *arg)
+{
+    uint32_t head;
+    uint64_t one;
+
+    (void)arg;
+    one = 1;
+    head = atomic_load_explicit(&gs_handle.event_head, memory_order_relaxed);        /* head before the scan */
+    (void)multi_button_process(&gs_handle);                                         /* scan */
+    if (atomic_load_explicit(&gs_handle.event_head, memory_order_relaxed) != head)   /* new events */
+    {
+        (void)write(gs_fd, &one, sizeof(uint64_t));                                 /* wake the consumer */
+    }
+}
+
+/**
+ * @brief  service config the driver
+ * @return status code
+ *         - 0 success
+ *         - 1 config failed
+ * @note   none
+ */
+static uint8_t a_service_config(void)
+{
+    if (multi_button_set_timeout(&gs_handle, MULTI_BUTTON_BASIC_DEFAULT_TIMEOUT) != 0)
+    {
+        return 1;
+    }
+    if (multi_button_set_interval(&gs_handle, MULTI_BUTTON_BASIC_DEFAULT_INTERVAL) != 0)
+    {
+        return 1;
+    }
+    if (multi_button_set_short_time(&gs_handle, MULTI_BUTTON_BASIC_DEFAULT_SHORT_TIME) != 0)
+    {
+        return 1;
+    }
+    if (multi_button_set_long_time(&gs_handle, MULTI_BUTTON_BASIC_DEFAULT_LONG_TIME) != 0)
+    {
+        return 1;
+    }
+    if (multi_button_set_repeat_time(&gs_handle, MULTI_BUTTON_BASIC_DEFAULT_REPEAT_TIME) != 0)
+    {
+        return 1;
+    }
+    if (multi_button_set_repeat_cnt(&gs_handle, MULTI_BUTTON_BASIC_DEFAULT_REPEAT_CNT) != 0)
+    {
+        return 1;
+    }
+    if (multi_button_set_period(&gs_handle, MULTI_BUTTON_BASIC_DEFAULT_PERIOD) != 0)
+    {
+        return 1;
+    }
+    if (multi_button_set_event_overflow_policy(&gs_handle, MULTI_BUTTON_OVERFLOW_DROP_OLDEST) != 0)
+    {
+        return 1;
+    }
+    if (multi_button_set_hold_coalesce(&gs_handle, MULTI_BUTTON_BOOL_TRUE) != 0)
+    {
+        return 1;
+    }
+    if (multi_button_set_event_ring(&gs_handle, MULTI_BUTTON_BOOL_TRUE) != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     service init
+ * @param[in] row max row of buttons
+ * @param[in] col max col of buttons
+ * @param[in] *param pointer to a scan param structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the scan thread pushes events into the driver event ring and signals an eventfd
+ */
+uint8_t service_init(uint8_t row, uint8_t col, const scan_param_t *param)
+{
+    uint8_t res;
+
+    if (gs_fd >= 0)
+    {
+        multi_button_interface_debug_print("service: service is running.\n");
+
+        return 1;
+    }
+
+    /* link interface function */
+    DRIVER_MULTI_BUTTON_LINK_INIT(&gs_handle, multi_button_handle_t);
+    DRIVER_MULTI_BUTTON_LINK_MATRIX_INIT(&gs_handle, multi_button_interface_matrix_init);
+    DRIVER_MULTI_BUTTON_LINK_MATRIX_DEINIT(&gs_handle, multi_button_interface_matrix_deinit);
+    DRIVER_MULTI_BUTTON_LINK_MATRIX_WRITE_ROW(&gs_handle, multi_button_interface_matrix_write_row);
+    DRIVER_MULTI_BUTTON_LINK_MATRIX_SELECT_ROW(&gs_handle, multi_button_interface_matrix_select_row);
+    DRIVER_MULTI_BUTTON_LINK_MATRIX_READ_ROW(&gs_handle, multi_button_interface_matrix_read_row);
+    DRIVER_MULTI_BUTTON_LINK_MATRIX_READ_ROW_TIMESTAMP(&gs_handle, multi_button_interface_matrix_read_row_timestamp);
+    DRIVER_MULTI_BUTTON_LINK_TIMESTAMP_READ(&gs_handle, multi_button_interface_timestamp_read);
+    DRIVER_MULTI_BUTTON_LINK_DELAY_MS(&gs_handle, multi_button_interface_delay_ms);
+    DRIVER_MULTI_BUTTON_LINK_DEBUG_PRINT(&gs_handle, multi_button_interface_debug_print);
+
+    /* init the driver with the storage of any matrix size */
+    if (multi_button_init_with_buffer(&gs_handle, row, col, gs_button, sizeof(gs_button)) != 0)
+    {
+        multi_button_interface_debug_print("service: init failed.\n");
+
+        return 1;
+    }
+
+    /* config the driver */
+    if (a_service_config() != 0)
+    {
+        multi_button_interface_debug_print("service: config failed.\n");
+        (void)multi_button_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* open the eventfd */
+    gs_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (gs_fd < 0)
+    {
+        multi_button_interface_debug_print("service: open eventfd failed.\n");
+        (void)multi_button_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    /* start the scan thread */
+    res = scan_start(param, a_service_process, NULL);
+    if (res != 0)
+    {
+        multi_button_interface_debug_print("service: scan start failed with code %d.\n", res);
+        (void)close(gs_fd);
+        gs_fd = -1;
+        (void)multi_button_deinit(&gs_handle);
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief  service deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t service_deinit(void)
+{
+    uint8_t res;
+
+    if (gs_fd < 0)
+    {
+        return 1;
+    }
+
+    /* stop the scan thread */
+    (void)scan_stop();
+
+    /* close the eventfd */
+    (void)close(gs_fd);
+    gs_fd = -1;
+
+    /* deinit the driver */
+    res = multi_button_deinit(&gs_handle);
+    if (res != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief  service get the pollable file descriptor
+ * @return file descriptor, -1 means not initialized
+ * @note   the fd is readable while events are pending,
+ *         it is cleared by service_pop when the ring is drained
+ */
+int service_get_fd(void)
+{
+    return gs_fd;
+}
+
+/**
+ * @brief      service pop an event
+ * @param[out] *event pointer to an event buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 pop failed
+ *             - 2 no event
+ * @note       only one consumer thread can pop events
+ */
+uint8_t service_pop(multi_button_event_t *event)
+{
+    uint8_t res;
+    uint64_t cnt;
+
+    if (gs_fd < 0)
+    {
+        return 1;
+    }
+
+    res = multi_button_event_pop(&gs_handle, event);
+    if (res == 0)
+    {
+        return 0;
+    }
+    else if (res != 4)
+    {
+        return 1;
+    }
+
+    /* the ring is empty, clear the eventfd and check again, */
+    /* so an event pushed before the clear is not left without a wakeup */
+    if ((read(gs_fd, &cnt, sizeof(uint64_t)) < 0) && (errno != EAGAIN))
+    {
+        return 1;
+    }
+    res = multi_button_event_pop(&gs_handle, event);
+    if (res == 0)
+    {
+        return 0;
+    }
+    else if (res != 4)
+    {
+        return 1;
+    }
+
+    return 2;
+}
+
+/**
+ * @brief      service get the dropped event count
+ * @param[out] *cnt pointer to a count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       none
+ */
+uint8_t service_get_overflow(uint32_t *cnt)
+{
+    if (gs_fd < 0)
+    {
+        return 1;
+    }
+
+    if (multi_button_get_event_overflow(&gs_handle, cnt) != 0)
+    {
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,475 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ * @file      load.c
+ * @brief     load test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "server.h"
+#include "client.h"
+#include <getopt.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief load client structure definition
+ */
+typedef struct load_client_s
+{
+    client_handle_t handle;        /**< client handle */
+    uint8_t slow;                  /**< slow client reads nothing until the end */
+    uint8_t error;                 /**< read error or out of order flag */
+    uint8_t seq_valid;             /**< seq valid flag */
+    uint32_t first_seq;            /**< first received seq */
+    uint32_t last_seq;             /**< last received seq */
+    uint32_t received;             /**< received records */
+} load_client_t;
+
+/**
+ * @brief global var definition
+ */
+static load_client_t *gs_client;                 /**< client table */
+static uint16_t gs_client_num;                   /**< client number */
+static char gs_path[108];                        /**< socket path */
+static atomic_int gs_connected;                  /**< all clients connected flag, -1 means failed */
+static atomic_int gs_slow_read;                  /**< slow clients start to read flag */
+static atomic_int gs_finish;                     /**< reader finish flag */
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_load_ns(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief     drain the records of a client
+ * @param[in] *client pointer to a load client structure
+ * @return    read records
+ * @note      none
+ */
+static uint32_t a_load_drain(load_client_t *client)
+{
+    uint8_t res;
+    uint32_t cnt;
+    protocol_record_t record;
+    
+    cnt = 0;
+    while (1)
+    {
+        res = client_read(&client->handle, &record, 0);
+        if (res == 2)
+        {
+            break;
+        }
+        if (res != 0)
+        {
+            client->error = 1;
+            
+            break;
+        }
+        if ((client->seq_valid != 0) && (record.seq <= client->last_seq))
+        {
+            client->error = 1;
+        }
+        if (client->seq_valid == 0)
+        {
+            client->first_seq = record.seq;
+            client->seq_valid = 1;
+        }
+        client->last_seq = record.seq;
+        client->received++;
+        cnt++;
+    }
+    
+    return cnt;
+}
+
+/**
+ * @brief     reader thread
+ * @param[in] *arg pointer to an argument
+ * @return    NULL
+ * @note      none
+ */
+static void *a_load_reader(void *arg)
+{
+    uint16_t i;
+    uint32_t cnt;
+    uint64_t idle;
+    struct pollfd *fds;
+    
+    (void)arg;
+    
+    /* connect all clients */
+    for (i = 0; i < gs_client_num; i++)
+    {
+        if (client_open(&gs_client[i].handle, gs_path) != 0)
+        {
+            atomic_store(&gs_connected, -1);
+            
+            return NULL;
+        }
+    }
+    fds = (struct pollfd *)malloc(sizeof(struct pollfd) * gs_client_num);
+    if (fds == NULL)
+    {
+        atomic_store(&gs_connected, -1);
+        
+        return NULL;
+    }
+    atomic_store(&gs_connected, 1);
+    
+    /* read the fast clients, and the slow ones after the publish */
+    idle = 0;
+    while (1)
+    {
+        for (i = 0; i < gs_client_num; i++)
+        {
+            fds[i].fd = ((gs_client[i].slow == 0) || (atomic_load(&gs_slow_read) != 0)) ?
+                        client_get_fd(&gs_client[i].handle) : -1;
+            fds[i].events = POLLIN;
+            fds[i].revents = 0;
+        }
+        cnt = 0;
+        if (poll(fds, gs_client_num, 10) > 0)
+        {
+            for (i = 0; i < gs_client_num; i++)
+            {
+                if (fds[i].revents != 0)
+                {
+                    cnt += a_load_drain(&gs_client[i]);
+                }
+            }
+        }
+        
+        /* finish after 100ms without data */
+        if (atomic_load(&gs_finish) != 0)
+        {
+            idle = (cnt == 0) ? idle + 1 : 0;
+            if (idle >= 10)
+            {
+                break;
+            }
+        }
+    }
+    
+    /* close all clients */
+    for (i = 0; i < gs_client_num; i++)
+    {
+        (void)client_close(&gs_client[i].handle);
+    }
+    free(fds);
+    
+    return NULL;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    uint16_t i;
+    uint16_t slow;
+    uint32_t k;
+    uint32_t events;
+    uint32_t interval_us;
+    uint32_t lost;
+    uint32_t fast_lost;
+    uint32_t slow_lost;
+    uint32_t error;
+    uint64_t start;
+    uint64_t used;
+    uint64_t max_ns;
+    uint64_t sum_ns;
+    uint64_t deadline;
+    uint8_t res;
+    pthread_t thread;
+    server_stat_t stat;
+    multi_button_event_t event;
+    struct timespec ts;
+    struct option long_options[] =
+    {
+        {"clients", required_argument, NULL, 1},
+        {"slow", required_argument, NULL, 2},
+        {"events", required_argument, NULL, 3},
+        {"interval", required_argument, NULL, 4},
+        {"socket", required_argument, NULL, 5},
+        {NULL, 0, NULL, 0},
+    };
+    
+    /* default params */
+    gs_client_num = 200;
+    slow = 0xFFFF;
+    events = 2000;
+    interval_us = 1000;
+    strcpy(gs_path, "/tmp/multi_button_load.sock");
+    
+    /* parse */
+    while ((c = getopt_long(argc, argv, "", long_options, NULL)) != -1)
+    {
+        switch (c)
+        {
+            case 1 :
+            {
+                if ((atol(optarg) <= 0) || (atol(optarg) > 65535))
+                {
+                    return 5;
+                }
+                gs_client_num = (uint16_t)atol(optarg);
+                
+                break;
+            }
+            case 2 :
+            {
+                slow = (uint16_t)atol(optarg);
+                
+                break;
+            }
+            case 3 :
+            {
+                events = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case 4 :
+            {
+                interval_us = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case 5 :
+            {
+                if (strlen(optarg) >= sizeof(gs_path))
+                {
+                    return 5;
+                }
+                strcpy(gs_path, optarg);
+                
+                break;
+            }
+            default :
+            {
+                printf("Usage:\n");
+                printf("  multi_button_load [--clients=<num>] [--slow=<num>] [--events=<num>] [--interval=<us>] [--socket=<path>]\n");
+                
+                return 5;
+            }
+        }
+    }
+    if (slow == 0xFFFF)
+    {
+        slow = gs_client_num / 10;
+    }
+    if ((slow > gs_client_num) || (events == 0))
+    {
+        return 5;
+    }
+    
+    /* alloc the clients, the first ones are slow */
+    gs_client = (load_client_t *)calloc(gs_client_num, sizeof(load_client_t));
+    if (gs_client == NULL)
+    {
+        return 1;
+    }
+    for (i = 0; i < slow; i++)
+    {
+        gs_client[i].slow = 1;
+    }
+    
+    /* server init */
+    res = server_init(gs_path, gs_client_num);
+    if (res != 0)
+    {
+        printf("multi_button: server init failed with code %d.\n", res);
+        free(gs_client);
+        
+        return 1;
+    }
+    printf("multi_button: %d clients with %d slow ones, %d events every %dus.\n",
+           gs_client_num, slow, events, interval_us);
+    
+    /* connect the clients */
+    atomic_store(&gs_connected, 0);
+    atomic_store(&gs_slow_read, 0);
+    atomic_store(&gs_finish, 0);
+    if (pthread_create(&thread, NULL, a_load_reader, NULL) != 0)
+    {
+        (void)server_deinit();
+        free(gs_client);
+        
+        return 1;
+    }
+    start = a_load_ns();
+    while (1)
+    {
+        (void)server_process(10);
+        (void)server_get_stat(&stat);
+        if ((stat.client == gs_client_num) && (atomic_load(&gs_connected) == 1))
+        {
+            break;
+        }
+        if ((atomic_load(&gs_connected) < 0) || (a_load_ns() - start > 10000000000ULL))
+        {
+            printf("multi_button: only %d clients connected.\n", stat.client);
+            atomic_store(&gs_finish, 1);
+            (void)pthread_join(thread, NULL);
+            (void)server_deinit();
+            free(gs_client);
+            
+            return 1;
+        }
+    }
+    printf("multi_button: %d clients connected in %0.1fms.\n", stat.client, (double)(a_load_ns() - start) / 1e6);
+    
+    /* publish the events */
+    memset(&event, 0, sizeof(multi_button_event_t));
+    max_ns = 0;
+    sum_ns = 0;
+    deadline = a_load_ns();
+    for (k = 0; k < events; k++)
+    {
+        event.seq = k;
+        event.row = (uint8_t)(k % 4);
+        event.col = (uint8_t)((k / 4) % 4);
+        event.index = (uint16_t)(event.row * 4 + event.col);
+        event.status = (uint16_t)(1 << (k % 11));
+        event.t.s = k / 1000;
+        event.t.us = (k % 1000) * 1000;
+        
+        /* time the publish */
+        start = a_load_ns();
+        (void)server_publish(&event);
+        used = a_load_ns() - start;
+        sum_ns += used;
+        if (used > max_ns)
+        {
+            max_ns = used;
+        }
+        
+        /* serve the sockets until the next event */
+        (void)server_process(0);
+        deadline += (uint64_t)interval_us * 1000;
+        ts.tv_sec = (time_t)(deadline / 1000000000ULL);
+        ts.tv_nsec = (long)(deadline % 1000000000ULL);
+        (void)clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+    }
+    printf("multi_button: publish costs %0.1fus on average and %0.1fus at most.\n",
+           (double)sum_ns / events / 1e3, (double)max_ns / 1e3);
+    
+    /* let the slow clients read and flush all rings */
+    atomic_store(&gs_slow_read, 1);
+    start = a_load_ns();
+    while (a_load_ns() - start < 10000000000ULL)
+    {
+        (void)server_process(10);
+        (void)server_get_stat(&stat);
+        if (stat.pending == 0)
+        {
+            break;
+        }
+    }
+    
+    /* wait for the reader, then reap the closed clients */
+    atomic_store(&gs_finish, 1);
+    (void)pthread_join(thread, NULL);
+    start = a_load_ns();
+    while (a_load_ns() - start < 1000000000ULL)
+    {
+        (void)server_process(10);
+        (void)server_get_stat(&stat);
+        if (stat.client == 0)
+        {
+            break;
+        }
+    }
+    
+    /* check the clients */
+    error = 0;
+    fast_lost = 0;
+    slow_lost = 0;
+    for (i = 0; i < gs_client_num; i++)
+    {
+        /* every record is received or counted as lost, and the newest one always arrives */
+        (void)client_get_lost(&gs_client[i].handle, &lost);
+        lost += gs_client[i].first_seq;
+        if ((gs_client[i].error != 0) || (gs_client[i].seq_valid == 0) ||
+            (gs_client[i].last_seq != events - 1) ||
+            (gs_client[i].received + lost != events))
+        {
+            error++;
+        }
+        if (gs_client[i].slow != 0)
+        {
+            slow_lost += lost;
+        }
+        else
+        {
+            fast_lost += lost;
+        }
+    }
+    printf("multi_button: fast clients lost %d records, slow clients lost %d records, server dropped %llu records.\n",
+           fast_lost, slow_lost, (unsigned long long)stat.dropped);
+    printf("multi_button: %d clients failed, %d clients left open.\n", error, stat.client);
+    (void)server_deinit();
+    free(gs_client);
+    
+    /* check the result */
+    if ((error != 0) || (fast_lost != 0) || (stat.client != 0) ||
+        ((uint64_t)slow_lost != stat.dropped))
+    {
+        printf("multi_button: load test failed.\n");
+        
+        return 1;
+    }
+    printf("multi_button: load test passed.\n");
+    
+    return 0;
+}
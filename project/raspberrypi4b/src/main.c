@@ -36,14 +36,26 @@
 
 #include "driver_multi_button_basic.h"
 #include "driver_multi_button_trigger_test.h"
+#include "driver_multi_button_decode_test.h"
+#include "clock.h"
+#include "client.h"
 #include "gpio.h"
+#include "scan.h"
+#include "server.h"
+#include "service.h"
 #include <getopt.h>
+#include <poll.h>
+#include <signal.h>
 #include <stdlib.h>
+#if defined(GPIO_BACKEND_MMAP)
+#include <fcntl.h>
+#endif
 
 /**
  * @brief global var definition
  */
 volatile uint16_t g_flag;                                   /**< interrupt flag */
+volatile sig_atomic_t g_stop;                               /**< stop flag */
 
 /**
  * @brief     interface receive callback
@@ -140,6 +152,201 @@ static void a_receive_callback(uint16_t row, uint16_t col, multi_button_t *data)
     }
 }
 
+/**
+ * @brief     stop signal handler
+ * @param[in] signum signal number
+ * @note      none
+ */
+static void a_stop_handler(int signum)
+{
+    (void)signum;
+
+    /* stop the loop */
+    g_stop = 1;
+}
+
+/**
+ * @brief     scan process
+ * @param[in] *arg pointer to an argument
+ * @note      none
+ */
+static void a_scan_process(void *arg)
+{
+    (void)arg;
+
+    /* process */
+    (void)multi_button_basic_process();
+}
+
+/**
+ * @brief  print the scan stat
+ * @note   none
+ */
+static void a_scan_print_stat(void)
+{
+    scan_stat_t stat;
+
+    if (scan_get_stat(&stat) == 0)
+    {
+        multi_button_interface_debug_print("multi_button: scan %llu cycles with %llu overruns.\n",
+                                           (unsigned long long)stat.cycle, (unsigned long long)stat.overrun);
+        multi_button_interface_debug_print("multi_button: scan jitter min %uns max %uns avg %uns.\n",
+                                           stat.jitter_min_ns, stat.jitter_max_ns, stat.jitter_avg_ns);
+    }
+}
+
+#if defined(GPIO_BACKEND_MMAP)
+/**
+ * @brief bcm2711 register definition of the mmap test
+ */
+#define MMAP_TEST_SIZE             4096            /**< fake register page size */
+#define MMAP_TEST_GPFSEL0          (0x00 / 4)      /**< function select 0 */
+#define MMAP_TEST_GPSET0           (0x1C / 4)      /**< output set 0 */
+#define MMAP_TEST_GPCLR0           (0x28 / 4)      /**< output clear 0 */
+#define MMAP_TEST_PUP_PDN0         (0xE4 / 4)      /**< pull up down control 0 */
+
+/**
+ * @brief      read the fake register page
+ * @param[in]  fd page file descriptor
+ * @param[out] *reg pointer to a register buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_mmap_test_read(int fd, uint32_t *reg)
+{
+    if (pread(fd, reg, MMAP_TEST_SIZE, 0) != MMAP_TEST_SIZE)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     mmap backend test with a fake register page
+ * @param[in] *map pointer to a pinmap structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      a 4096 byte temp file is mapped instead of /dev/gpiomem,
+ *            the function select, pull, set and clear registers are checked after init and select_row
+ */
+static uint8_t a_mmap_test(const pinmap_t *map)
+{
+    char file[] = "/tmp/multi_button_gpio_XXXXXX";
+    pinmap_t fake;
+    uint32_t fsel[6];
+    uint32_t pull[4];
+    uint32_t mask[2];
+    uint32_t bit;
+    uint32_t bank;
+    uint32_t *reg;
+    uint8_t res;
+    uint8_t i;
+    int fd;
+
+    /* create the fake register page */
+    reg = (uint32_t *)calloc(MMAP_TEST_SIZE / 4, sizeof(uint32_t));
+    if (reg == NULL)
+    {
+        return 1;
+    }
+    fd = mkstemp(file);
+    if (fd < 0)
+    {
+        free(reg);
+
+        return 1;
+    }
+    if (ftruncate(fd, MMAP_TEST_SIZE) != 0)
+    {
+        res = 1;
+
+        goto exit;
+    }
+
+    /* map the page */
+    memcpy(&fake, map, sizeof(pinmap_t));
+    snprintf(fake.chip, PINMAP_CHIP_SIZE, "%s", file);
+    if ((gpio_matrix_set_map(&fake) != 0) || (gpio_matrix_init() != 0))
+    {
+        multi_button_interface_debug_print("multi_button: mmap init failed.\n");
+        res = 1;
+
+        goto exit;
+    }
+
+    /* get the expected values */
+    memset(fsel, 0, sizeof(fsel));
+    memset(pull, 0, sizeof(pull));
+    memset(mask, 0, sizeof(mask));
+    for (i = 0; i < fake.row_num; i++)
+    {
+        fsel[fake.row[i] / 10] |= (uint32_t)0x1 << ((fake.row[i] % 10) * 3);
+        mask[fake.row[i] / 32] |= (uint32_t)1 << (fake.row[i] % 32);
+    }
+    for (i = 0; i < fake.col_num; i++)
+    {
+        pull[fake.col[i] / 16] |= (uint32_t)0x1 << ((fake.col[i] % 16) * 2);
+    }
+
+    /* check the init */
+    res = a_mmap_test_read(fd, reg);
+    if ((res != 0) ||
+        (memcmp(&reg[MMAP_TEST_GPFSEL0], fsel, sizeof(fsel)) != 0) ||
+        (memcmp(&reg[MMAP_TEST_PUP_PDN0], pull, sizeof(pull)) != 0) ||
+        (memcmp(&reg[MMAP_TEST_GPSET0], mask, sizeof(mask)) != 0))
+    {
+        multi_button_interface_debug_print("multi_button: mmap init registers are wrong.\n");
+        res = 1;
+
+        goto deinit;
+    }
+    multi_button_interface_debug_print("multi_button: mmap init registers are right.\n");
+
+    /* check select row */
+    for (i = 0; i < fake.row_num; i++)
+    {
+        if (gpio_matrix_select_row(i) != 0)
+        {
+            multi_button_interface_debug_print("multi_button: mmap select row failed.\n");
+            res = 1;
+
+            goto deinit;
+        }
+        bank = fake.row[i] / 32;
+        bit = (uint32_t)1 << (fake.row[i] % 32);
+        res = a_mmap_test_read(fd, reg);
+        if ((res != 0) ||
+            (reg[MMAP_TEST_GPSET0 + bank] != (mask[bank] & ~bit)) ||
+            (reg[MMAP_TEST_GPSET0 + 1 - bank] != mask[1 - bank]) ||
+            (reg[MMAP_TEST_GPCLR0 + bank] != bit))
+        {
+            multi_button_interface_debug_print("multi_button: mmap select row %d registers are wrong.\n", i);
+            res = 1;
+
+            goto deinit;
+        }
+    }
+    multi_button_interface_debug_print("multi_button: mmap select row registers are right.\n");
+
+    deinit:
+    if (gpio_matrix_deinit() != 0)
+    {
+        res = 1;
+    }
+
+    exit:
+    (void)close(fd);
+    (void)unlink(file);
+    free(reg);
+
+    return res;
+}
+#endif
+
 /**
  * @brief     multi_button full function
  * @param[in] argc arg numbers
@@ -162,9 +369,30 @@ uint8_t multi_button(uint8_t argc, char **argv)
         {"port", no_argument, NULL, 'p'},
         {"example", required_argument, NULL, 'e'},
         {"test", required_argument, NULL, 't'},
+        {"period", required_argument, NULL, 1},
+        {"priority", required_argument, NULL, 2},
+        {"cpu", required_argument, NULL, 3},
+        {"mlock", no_argument, NULL, 4},
+        {"map", required_argument, NULL, 5},
+        {"rows", required_argument, NULL, 6},
+        {"cols", required_argument, NULL, 7},
+        {"chip", required_argument, NULL, 8},
+        {"clock", required_argument, NULL, 9},
+        {"socket", required_argument, NULL, 10},
+        {"clients", required_argument, NULL, 11},
         {NULL, 0, NULL, 0},
     };
     char type[33] = "unknown";
+    scan_param_t param = {5000, 0, -1, 0};
+    pinmap_t map;
+    clock_source_t source;
+    char path[108] = PROTOCOL_DEFAULT_PATH;
+    uint16_t clients = 32;
+    uint8_t i;
+    uint8_t res;
+
+    /* default pin map */
+    pinmap_init(&map);
 
     /* if no params */
     if (argc == 1)
@@ -235,6 +463,135 @@ uint8_t multi_button(uint8_t argc, char **argv)
                 break;
             }
 
+            /* period */
+            case 1 :
+            {
+                /* set the period */
+                param.period_us = atol(optarg);
+
+                break;
+            }
+
+            /* priority */
+            case 2 :
+            {
+                /* set the priority */
+                param.priority = atol(optarg);
+
+                break;
+            }
+
+            /* cpu */
+            case 3 :
+            {
+                /* set the cpu */
+                param.cpu = atol(optarg);
+
+                break;
+            }
+
+            /* mlock */
+            case 4 :
+            {
+                /* lock the memory */
+                param.lock_memory = 1;
+
+                break;
+            }
+
+            /* map */
+            case 5 :
+            {
+                /* load the map file */
+                res = pinmap_load(&map, optarg);
+                if (res != 0)
+                {
+                    multi_button_interface_debug_print("multi_button: load %s failed with code %d.\n", optarg, res);
+
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* rows */
+            case 6 :
+            {
+                /* set the row lines */
+                if (pinmap_parse_list(optarg, map.row, &map.row_num) != 0)
+                {
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* cols */
+            case 7 :
+            {
+                /* set the col lines */
+                if (pinmap_parse_list(optarg, map.col, &map.col_num) != 0)
+                {
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* chip */
+            case 8 :
+            {
+                /* set the chip */
+                if (strlen(optarg) >= PINMAP_CHIP_SIZE)
+                {
+                    return 5;
+                }
+                memset(map.chip, 0, sizeof(map.chip));
+                strcpy(map.chip, optarg);
+
+                break;
+            }
+
+            /* clock */
+            case 9 :
+            {
+                /* set the timestamp source */
+                if (clock_parse(optarg, &source) != 0)
+                {
+                    return 5;
+                }
+                clock_set_source(source);
+
+                break;
+            }
+
+            /* socket */
+            case 10 :
+            {
+                /* set the socket path */
+                if (strlen(optarg) >= sizeof(path))
+                {
+                    return 5;
+                }
+                memset(path, 0, sizeof(path));
+                strcpy(path, optarg);
+
+                break;
+            }
+
+            /* clients */
+            case 11 :
+            {
+                /* set the max client number */
+                if ((atol(optarg) <= 0) || (atol(optarg) > 65535))
+                {
+                    return 5;
+                }
+                clients = (uint16_t)atol(optarg);
+
+                break;
+            }
+
             /* the end */
             case -1 :
             {
@@ -249,29 +606,105 @@ uint8_t multi_button(uint8_t argc, char **argv)
         }
     } while (c != -1);
 
+    /* set the pin map */
+    if (gpio_matrix_set_map(&map) != 0)
+    {
+        multi_button_interface_debug_print("multi_button: pin map is invalid.\n");
+
+        return 5;
+    }
+
     /* run the function */
     if (strcmp("t_trigger", type) == 0)
     {
-        uint8_t res;
+        /* check the inline storage */
+        if (map.row_num * map.col_num > MULTI_BUTTON_NUMBER)
+        {
+            multi_button_interface_debug_print("multi_button: test supports %d buttons, use -e poll for larger maps.\n", MULTI_BUTTON_NUMBER);
+
+            return 1;
+        }
 
         /* run the trigger test */
-        res = multi_button_trigger_test(4, 4);
+        res = multi_button_trigger_test(map.row_num, map.col_num);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_clock", type) == 0)
+    {
+        double ns;
+
+        /* benchmark all sources */
+        for (i = 0; i <= CLOCK_SOURCE_REALTIME; i++)
+        {
+            res = clock_benchmark((clock_source_t)i, 1000000, &ns);
+            if (res != 0)
+            {
+                multi_button_interface_debug_print("multi_button: %s clock read failed.\n", clock_get_name((clock_source_t)i));
+
+                return 1;
+            }
+            multi_button_interface_debug_print("multi_button: %s clock read costs %0.1fns.\n", clock_get_name((clock_source_t)i), ns);
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_decode", type) == 0)
+    {
+        /* run the decode test */
+        res = multi_button_decode_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+#if defined(GPIO_BACKEND_MMAP)
+    else if (strcmp("t_mmap", type) == 0)
+    {
+        /* run the mmap test */
+        multi_button_interface_debug_print("multi_button: start mmap test.\n");
+        res = a_mmap_test(&map);
         if (res != 0)
         {
             return 1;
         }
+        multi_button_interface_debug_print("multi_button: finish mmap test.\n");
 
         return 0;
     }
+#endif
     else if (strcmp("e_trigger", type) == 0)
     {
-        uint8_t res;
         uint32_t timeout;
 
+        /* check the inline storage */
+        if (map.row_num * map.col_num > MULTI_BUTTON_NUMBER)
+        {
+            multi_button_interface_debug_print("multi_button: example supports %d buttons, use -e poll for larger maps.\n", MULTI_BUTTON_NUMBER);
+
+            return 1;
+        }
+
         /* basic init */
-        res = multi_button_basic_init(4, 4, a_receive_callback);
+        res = multi_button_basic_init(map.row_num, map.col_num, a_receive_callback);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        /* start the scan */
+        res = scan_start(&param, a_scan_process, NULL);
         if (res != 0)
         {
+            multi_button_interface_debug_print("multi_button: scan start failed with code %d.\n", res);
+            (void)multi_button_basic_deinit();
+
             return 1;
         }
 
@@ -293,13 +726,14 @@ uint8_t multi_button(uint8_t argc, char **argv)
             /* timeout -- */
             timeout--;
             
-            /* delay 5ms */
-            multi_button_interface_delay_ms(5);
-            
-            /* process */
-            (void)multi_button_basic_process();
+            /* delay 10ms */
+            multi_button_interface_delay_ms(10);
         }
 
+        /* stop the scan */
+        (void)scan_stop();
+        a_scan_print_stat();
+
         /* check the timeout */
         if (timeout == 0)
         {
@@ -318,22 +752,238 @@ uint8_t multi_button(uint8_t argc, char **argv)
 
         return 0;
     }
+    else if (strcmp("e_poll", type) == 0)
+    {
+        uint32_t timeout;
+        struct pollfd fds;
+        multi_button_event_t event;
+        multi_button_t data;
+
+        /* service init */
+        res = service_init(map.row_num, map.col_num, &param);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        /* 100s idle timeout */
+        timeout = 100;
+
+        /* init 0 */
+        g_flag = 0;
+
+        /* set the poll fd */
+        fds.fd = service_get_fd();
+        fds.events = POLLIN;
+
+        /* check timeout */
+        while (timeout != 0)
+        {
+            /* check the flag */
+            if ((g_flag & 0x07FF) == 0x07FF)
+            {
+                break;
+            }
+
+            /* wait 1s for the events */
+            fds.revents = 0;
+            if (poll(&fds, 1, 1000) <= 0)
+            {
+                /* timeout -- */
+                timeout--;
+
+                continue;
+            }
+
+            /* pop all events */
+            while (service_pop(&event) == 0)
+            {
+                data.status = event.status;
+                data.times = event.times;
+                data.id = event.id;
+                a_receive_callback(event.row, event.col, &data);
+            }
+        }
+
+        /* print the scan stat */
+        a_scan_print_stat();
+
+        /* check the timeout */
+        if (timeout == 0)
+        {
+            /* receive timeout */
+            multi_button_interface_debug_print("multi_button: poll timeout.\n");
+            (void)service_deinit();
+
+            return 1;
+        }
+
+        /* trigger all */
+        multi_button_interface_debug_print("multi_button: poll all.\n");
+
+        /* service deinit */
+        (void)service_deinit();
+
+        return 0;
+    }
+    else if (strcmp("e_daemon", type) == 0)
+    {
+        struct pollfd fds[2];
+        multi_button_event_t event;
+        server_stat_t stat;
+
+        /* server init */
+        res = server_init(path, clients);
+        if (res != 0)
+        {
+            multi_button_interface_debug_print("multi_button: server init failed with code %d.\n", res);
+
+            return 1;
+        }
+
+        /* service init */
+        res = service_init(map.row_num, map.col_num, &param);
+        if (res != 0)
+        {
+            (void)server_deinit();
+
+            return 1;
+        }
+
+        /* run until SIGINT or SIGTERM */
+        g_stop = 0;
+        (void)signal(SIGINT, a_stop_handler);
+        (void)signal(SIGTERM, a_stop_handler);
+        multi_button_interface_debug_print("multi_button: daemon listens on %s.\n", path);
+
+        /* set the poll fds */
+        fds[0].fd = service_get_fd();
+        fds[0].events = POLLIN;
+        fds[1].fd = server_get_fd();
+        fds[1].events = POLLIN;
+
+        while (g_stop == 0)
+        {
+            /* wait for the events or the sockets */
+            fds[0].revents = 0;
+            fds[1].revents = 0;
+            if (poll(fds, 2, 1000) <= 0)
+            {
+                continue;
+            }
+
+            /* publish all events, the slow clients only drop their oldest records */
+            while (service_pop(&event) == 0)
+            {
+                (void)server_publish(&event);
+            }
+
+            /* accept, flush and close the clients */
+            if ((fds[1].revents & POLLIN) != 0)
+            {
+                (void)server_process(0);
+            }
+        }
+
+        /* print the stat */
+        if (server_get_stat(&stat) == 0)
+        {
+            multi_button_interface_debug_print("multi_button: published %llu events to %llu clients with %llu dropped records.\n",
+                                               (unsigned long long)stat.published, (unsigned long long)stat.accepted,
+                                               (unsigned long long)stat.dropped);
+        }
+        a_scan_print_stat();
+
+        /* deinit */
+        (void)service_deinit();
+        (void)server_deinit();
+
+        return 0;
+    }
+    else if (strcmp("e_client", type) == 0)
+    {
+        client_handle_t handle;
+        protocol_record_t record;
+        multi_button_t data;
+        uint32_t lost;
+
+        /* connect the daemon */
+        res = client_open(&handle, path);
+        if (res != 0)
+        {
+            multi_button_interface_debug_print("multi_button: connect %s failed.\n", path);
+
+            return 1;
+        }
+
+        /* run until SIGINT, SIGTERM or the daemon exits */
+        g_stop = 0;
+        (void)signal(SIGINT, a_stop_handler);
+        (void)signal(SIGTERM, a_stop_handler);
+        while (g_stop == 0)
+        {
+            res = client_read(&handle, &record, 1000);
+            if (res == 1)
+            {
+                break;
+            }
+            if (res == 0)
+            {
+                data.status = record.status;
+                data.times = record.times;
+                data.id = record.id;
+                a_receive_callback(record.row, record.col, &data);
+            }
+        }
+
+        /* print the lost records */
+        (void)client_get_lost(&handle, &lost);
+        multi_button_interface_debug_print("multi_button: client lost %d records.\n", lost);
+        (void)client_close(&handle);
+
+        return 0;
+    }
     else if (strcmp("h", type) == 0)
     {
         help:
         multi_button_interface_debug_print("Usage:\n");
         multi_button_interface_debug_print("  multi_button (-i | --information)\n");
         multi_button_interface_debug_print("  multi_button (-h | --help)\n");
-        multi_button_interface_debug_print("  multi_button (-p | --port)\n");
-        multi_button_interface_debug_print("  multi_button (-t trigger | --test=trigger)\n");
-        multi_button_interface_debug_print("  multi_button (-e trigger | --example=trigger)\n");
+        multi_button_interface_debug_print("  multi_button (-p | --port) [--map=<file>] [--chip=<path>] [--rows=<lines>] [--cols=<lines>]\n");
+        multi_button_interface_debug_print("  multi_button (-t trigger | --test=trigger) [--map=<file>] [--chip=<path>] [--rows=<lines>] [--cols=<lines>]\n");
+        multi_button_interface_debug_print("               [--clock=<monotonic | raw | realtime>]\n");
+        multi_button_interface_debug_print("  multi_button (-t clock | --test=clock)\n");
+        multi_button_interface_debug_print("  multi_button (-t decode | --test=decode)\n");
+        multi_button_interface_debug_print("  multi_button (-t mmap | --test=mmap) [--map=<file>] [--rows=<lines>] [--cols=<lines>]\n");
+        multi_button_interface_debug_print("  multi_button (-e trigger | --example=trigger) [--map=<file>] [--chip=<path>] [--rows=<lines>] [--cols=<lines>]\n");
+        multi_button_interface_debug_print("               [--period=<us>] [--priority=<prio>] [--cpu=<cpu>] [--mlock] [--clock=<monotonic | raw | realtime>]\n");
+        multi_button_interface_debug_print("  multi_button (-e poll | --example=poll) [--map=<file>] [--chip=<path>] [--rows=<lines>] [--cols=<lines>]\n");
+        multi_button_interface_debug_print("               [--period=<us>] [--priority=<prio>] [--cpu=<cpu>] [--mlock] [--clock=<monotonic | raw | realtime>]\n");
+        multi_button_interface_debug_print("  multi_button (-e daemon | --example=daemon) [--map=<file>] [--chip=<path>] [--rows=<lines>] [--cols=<lines>]\n");
+        multi_button_interface_debug_print("               [--period=<us>] [--priority=<prio>] [--cpu=<cpu>] [--mlock] [--clock=<monotonic | raw | realtime>]\n");
+        multi_button_interface_debug_print("               [--socket=<path>] [--clients=<num>]\n");
+        multi_button_interface_debug_print("  multi_button (-e client | --example=client) [--socket=<path>]\n");
         multi_button_interface_debug_print("\n");
         multi_button_interface_debug_print("Options:\n");
-        multi_button_interface_debug_print("  -e <trigger>, --example=<trigger>    Run the driver example.\n");
+        multi_button_interface_debug_print("  -e <trigger | poll | daemon | client>, --example=<trigger | poll | daemon | client>\n");
+        multi_button_interface_debug_print("                                       Run the driver example.\n");
         multi_button_interface_debug_print("  -h, --help                           Show the help.\n");
         multi_button_interface_debug_print("  -i, --information                    Show the chip information.\n");
         multi_button_interface_debug_print("  -p, --port                           Display the pin connections of the current board.\n");
-        multi_button_interface_debug_print("  -t <trigger>, --test=<trigger>       Run the driver test.\n");
+        multi_button_interface_debug_print("  -t <trigger | clock | decode | mmap>, --test=<trigger | clock | decode | mmap>\n");
+        multi_button_interface_debug_print("                                       Run the driver test.\n");
+        multi_button_interface_debug_print("      --chip=<path>                    Set the gpio chip.([default: /dev/gpiochip0])\n");
+        multi_button_interface_debug_print("      --clients=<num>                  Set the max client number of the daemon.([default: 32])\n");
+        multi_button_interface_debug_print("      --clock=<monotonic | raw | realtime>\n");
+        multi_button_interface_debug_print("                                       Set the timestamp clock.([default: monotonic])\n");
+        multi_button_interface_debug_print("      --cols=<lines>                   Set the col line offsets, such as 6,13,19,26.\n");
+        multi_button_interface_debug_print("      --cpu=<cpu>                      Set the cpu affinity of the scan thread.\n");
+        multi_button_interface_debug_print("      --map=<file>                     Load the chip, row and col lines from a map file.\n");
+        multi_button_interface_debug_print("      --mlock                          Lock all memory of the process.\n");
+        multi_button_interface_debug_print("      --period=<us>                    Set the scan period in us.([default: 5000])\n");
+        multi_button_interface_debug_print("      --priority=<prio>                Set the SCHED_FIFO priority of the scan thread, 0 means the default policy.\n");
+        multi_button_interface_debug_print("      --rows=<lines>                   Set the row line offsets, such as 17,27,22,5.\n");
+        multi_button_interface_debug_print("      --socket=<path>                  Set the unix socket path.([default: /tmp/multi_button.sock])\n");
 
         return 0;
     }
@@ -358,14 +1008,15 @@ uint8_t multi_button(uint8_t argc, char **argv)
     else if (strcmp("p", type) == 0)
     {
         /* print pin connection */
-        multi_button_interface_debug_print("multi_button: ROW0 connected to GPIO17(BCM).\n");
-        multi_button_interface_debug_print("multi_button: ROW1 connected to GPIO27(BCM).\n");
-        multi_button_interface_debug_print("multi_button: ROW2 connected to GPIO22(BCM).\n");
-        multi_button_interface_debug_print("multi_button: ROW3 connected to GPIO5(BCM).\n");
-        multi_button_interface_debug_print("multi_button: COL0 connected to GPIO6(BCM).\n");
-        multi_button_interface_debug_print("multi_button: COL1 connected to GPIO13(BCM).\n");
-        multi_button_interface_debug_print("multi_button: COL2 connected to GPIO19(BCM).\n");
-        multi_button_interface_debug_print("multi_button: COL3 connected to GPIO26(BCM).\n");
+        multi_button_interface_debug_print("multi_button: gpio chip is %s.\n", map.chip);
+        for (i = 0; i < map.row_num; i++)
+        {
+            multi_button_interface_debug_print("multi_button: ROW%d connected to GPIO%d(BCM).\n", i, map.row[i]);
+        }
+        for (i = 0; i < map.col_num; i++)
+        {
+            multi_button_interface_debug_print("multi_button: COL%d connected to GPIO%d(BCM).\n", i, map.col[i]);
+        }
 
         return 0;
     }
@@ -38,21 +38,40 @@
 #include "delay.h"
 #include "uart.h"
 #include "tim.h"
+#include "dwt.h"
 #include <stdarg.h>
 
+/**
+ * @brief timestamp source definition
+ */
+#define MULTI_BUTTON_INTERFACE_TIMESTAMP_TIM        0        /**< tim2 counter with the second count */
+#define MULTI_BUTTON_INTERFACE_TIMESTAMP_DWT        1        /**< dwt cycle counter */
+
+/**
+ * @brief timestamp source selection, tim by default
+ */
+#ifndef MULTI_BUTTON_INTERFACE_TIMESTAMP
+    #define MULTI_BUTTON_INTERFACE_TIMESTAMP MULTI_BUTTON_INTERFACE_TIMESTAMP_TIM
+#endif
+
 /**
  * @brief timer var definition
  */
-static uint64_t gs_second = 0;        /**< second */
+static volatile uint64_t gs_second = 0;        /**< second */
 
 /**
  * @brief     timer callback
  * @param[in] us timer cnt
- * @note      none
+ * @note      with the dwt source the timer only keeps the 64 bits cycle counter extended
  */
 static void gs_tim_irq(uint32_t us)
 {
+#if (MULTI_BUTTON_INTERFACE_TIMESTAMP == MULTI_BUTTON_INTERFACE_TIMESTAMP_DWT)
+    (void)us;
+    (void)dwt_get_cycle64();
+#else
     gs_second += us / 1000000;
+#endif
 }
 
 /**
@@ -64,6 +83,14 @@ static void gs_tim_irq(uint32_t us)
  */
 uint8_t multi_button_interface_timer_init(void)
 {
+#if (MULTI_BUTTON_INTERFACE_TIMESTAMP == MULTI_BUTTON_INTERFACE_TIMESTAMP_DWT)
+    /* dwt init */
+    if (dwt_init() != 0)
+    {
+        return 1;
+    }
+#endif
+    
     /* timer init */
     if (tim_init(1000000, gs_tim_irq) != 0)
     {
@@ -208,12 +235,25 @@ uint8_t multi_button_interface_matrix_read_row(uint32_t *col_array)
  * @return    status code
  *            - 0 success
  *            - 1 read failed
- * @note      none
+ * @note      the tim source reads the second count again after the counter and retries
+ *            if the update irq ran between them, so the time never steps back by 1s
  */
 uint8_t multi_button_interface_timestamp_read(multi_button_time_t *t)
 {
-    t->s = gs_second;
-    t->us = tim_get_handle()->Instance->CNT;
+#if (MULTI_BUTTON_INTERFACE_TIMESTAMP == MULTI_BUTTON_INTERFACE_TIMESTAMP_DWT)
+    dwt_read(&t->s, &t->us);
+#else
+    uint64_t s;
+    uint32_t us;
+    
+    do
+    {
+        s = gs_second;
+        us = tim_get_handle()->Instance->CNT;
+    } while (s != gs_second);
+    t->s = s;
+    t->us = us;
+#endif
     
     return 0;
 }
@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2022 - present LibTutorial All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ * @file      dwt.h
+ * @brief     dwt header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DWT_H
+#define DWT_H
+
+#include "stm32f4xx_hal.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup dwt dwt function
+ * @brief    dwt function modules
+ * @{
+ */
+
+/**
+ * @brief  dwt init
+ * @return status code
+ *         - 0 success
+ *         - 1 cycle counter is not supported
+ * @note   the cycle counter runs at SystemCoreClock
+ */
+uint8_t dwt_init(void);
+
+/**
+ * @brief  dwt deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t dwt_deinit(void);
+
+/**
+ * @brief  dwt get the 32 bits cycle counter
+ * @return cycle counter
+ * @note   none
+ */
+uint32_t dwt_get_cycle(void);
+
+/**
+ * @brief  dwt get the 64 bits cycle counter
+ * @return cycle counter
+ * @note   the high word is counted in software, so it must be called at least
+ *         once per 2^32 cycles, that is about 25.5s at 168MHz
+ */
+uint64_t dwt_get_cycle64(void);
+
+/**
+ * @brief      dwt read the timestamp
+ * @param[out] *s pointer to a second buffer
+ * @param[out] *us pointer to a microsecond buffer
+ * @note       none
+ */
+void dwt_read(uint64_t *s, uint32_t *us);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2022 - present LibTutorial All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ * @file      dwt.c
+ * @brief     dwt source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "dwt.h"
+
+/**
+ * @brief dwt var definition
+ */
+static uint32_t gs_high = 0;        /**< high word of the cycle counter */
+static uint32_t gs_last = 0;        /**< last low word of the cycle counter */
+
+/**
+ * @brief  dwt init
+ * @return status code
+ *         - 0 success
+ *         - 1 cycle counter is not supported
+ * @note   the cycle counter runs at SystemCoreClock
+ */
+uint8_t dwt_init(void)
+{
+    /* enable the trace */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    
+    /* check the cycle counter */
+    if ((DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk) != 0)
+    {
+        return 1;
+    }
+    
+    /* reset and start the cycle counter */
+    DWT->CYCCNT = 0;
+    gs_high = 0;
+    gs_last = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    
+    return 0;
+}
+
+/**
+ * @brief  dwt deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t dwt_deinit(void)
+{
+    /* stop the cycle counter */
+    DWT->CTRL &= ~DWT_CTRL_CYCCNTENA_Msk;
+    
+    return 0;
+}
+
+/**
+ * @brief  dwt get the 32 bits cycle counter
+ * @return cycle counter
+ * @note   none
+ */
+uint32_t dwt_get_cycle(void)
+{
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief  dwt get the 64 bits cycle counter
+ * @return cycle counter
+ * @note   the high word is counted in software, so it must be called at least
+ *         once per 2^32 cycles, that is about 25.5s at 168MHz
+ */
+uint64_t dwt_get_cycle64(void)
+{
+    uint32_t primask;
+    uint32_t now;
+    uint64_t cycle;
+    
+    /* the irq and the thread both extend the counter */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    now = DWT->CYCCNT;
+    if (now < gs_last)
+    {
+        gs_high++;
+    }
+    gs_last = now;
+    cycle = ((uint64_t)gs_high << 32) | now;
+    __set_PRIMASK(primask);
+    
+    return cycle;
+}
+
+/**
+ * @brief      dwt read the timestamp
+ * @param[out] *s pointer to a second buffer
+ * @param[out] *us pointer to a microsecond buffer
+ * @note       none
+ */
+void dwt_read(uint64_t *s, uint32_t *us)
+{
+    uint64_t cycle;
+    
+    cycle = dwt_get_cycle64();
+    *s = cycle / SystemCoreClock;
+    *us = (uint32_t)((cycle % SystemCoreClock) / (SystemCoreClock / 1000000));
+}
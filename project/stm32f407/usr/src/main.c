@@ -39,6 +39,7 @@
 #include "shell.h"
 #include "clock.h"
 #include "delay.h"
+#include "dwt.h"
 #include "tim.h"
 #include "uart.h"
 #include "getopt.h"
@@ -270,6 +271,32 @@ uint8_t multi_button(uint8_t argc, char **argv)
 
         return 0;
     }
+    else if (strcmp("t_clock", type) == 0)
+    {
+        uint32_t i;
+        uint32_t start;
+        uint32_t cycle;
+        multi_button_time_t t;
+
+        /* the cycle counter times the reads */
+        if (dwt_init() != 0)
+        {
+            multi_button_interface_debug_print("multi_button: dwt is not supported.\n");
+
+            return 1;
+        }
+
+        /* time the timestamp read */
+        start = dwt_get_cycle();
+        for (i = 0; i < 1000; i++)
+        {
+            (void)multi_button_interface_timestamp_read(&t);
+        }
+        cycle = dwt_get_cycle() - start;
+        multi_button_interface_debug_print("multi_button: timestamp read costs %d.%d cycles.\n", cycle / 1000, (cycle % 1000) / 100);
+
+        return 0;
+    }
     else if (strcmp("e_trigger", type) == 0)
     {
         uint8_t res;
@@ -333,6 +360,7 @@ uint8_t multi_button(uint8_t argc, char **argv)
         multi_button_interface_debug_print("  multi_button (-h | --help)\n");
         multi_button_interface_debug_print("  multi_button (-p | --port)\n");
         multi_button_interface_debug_print("  multi_button (-t trigger | --test=trigger)\n");
+        multi_button_interface_debug_print("  multi_button (-t clock | --test=clock)\n");
         multi_button_interface_debug_print("  multi_button (-e trigger | --example=trigger)\n");
         multi_button_interface_debug_print("\n");
         multi_button_interface_debug_print("Options:\n");
@@ -340,7 +368,8 @@ uint8_t multi_button(uint8_t argc, char **argv)
         multi_button_interface_debug_print("  -h, --help                           Show the help.\n");
         multi_button_interface_debug_print("  -i, --information                    Show the chip information.\n");
         multi_button_interface_debug_print("  -p, --port                           Display the pin connections of the current board.\n");
-        multi_button_interface_debug_print("  -t <trigger>, --test=<trigger>       Run the driver test.\n");
+        multi_button_interface_debug_print("  -t <trigger | clock>, --test=<trigger | clock>\n");
+        multi_button_interface_debug_print("                                       Run the driver test.\n");
 
         return 0;
     }
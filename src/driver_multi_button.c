@@ -51,13 +51,34 @@
 /**
  * @brief multi_button check definition
  */
-#define MULTI_BUTTON_SHORT_TIME       (1000 * 1000)          /**< 1s */
-#define MULTI_BUTTON_LONG_TIME        (3 * 1000 * 1000)      /**< 3s */
-#define MULTI_BUTTON_REPEAT_TIME      (200 * 1000)           /**< 200ms */
-#define MULTI_BUTTON_INTERVAL         (5 * 1000)             /**< 5ms */
-#define MULTI_BUTTON_TIMEOUT          (1000 * 1000)          /**< 1s */
-#define MULTI_BUTTON_REPEAT_CNT       (2)                    /**< 2 */
-#define MULTI_BUTTON_PERIOD           (200 * 1000)           /**< 200ms */
+#define MULTI_BUTTON_SHORT_TIME               (1000 * 1000)          /**< 1s */
+#define MULTI_BUTTON_LONG_TIME                (3 * 1000 * 1000)      /**< 3s */
+#define MULTI_BUTTON_REPEAT_TIME              (200 * 1000)           /**< 200ms */
+#define MULTI_BUTTON_INTERVAL                 (5 * 1000)             /**< 5ms */
+#define MULTI_BUTTON_TIMEOUT                  (1000 * 1000)          /**< 1s */
+#define MULTI_BUTTON_REPEAT_CNT               (2)                    /**< 2 */
+#define MULTI_BUTTON_PERIOD                   (200 * 1000)           /**< 200ms */
+#define MULTI_BUTTON_TYPEMATIC_DELAY          (500 * 1000)           /**< 500ms */
+#define MULTI_BUTTON_TYPEMATIC_INTERVAL       (100 * 1000)           /**< 100ms */
+#define MULTI_BUTTON_TYPEMATIC_MIN_INTERVAL   (33 * 1000)            /**< 33ms */
+#define MULTI_BUTTON_TYPEMATIC_ACCELERATION   (10)                   /**< 10% */
+#define MULTI_BUTTON_GESTURE                  (0xFFFF)               /**< all gestures */
+
+/**
+ * @brief multi_button multi click mask definition
+ */
+#define MULTI_BUTTON_MULTI_CLICK_MASK         (MULTI_BUTTON_STATUS_DOUBLE_CLICK | \
+                                               MULTI_BUTTON_STATUS_TRIPLE_CLICK | \
+                                               MULTI_BUTTON_STATUS_REPEAT_CLICK)        /**< multi click mask */
+
+/**
+ * @brief multi_button hold merge word definition
+ * @note  bit 31 is the open flag, bit 16 - 30 is the ring position of the queued hold,
+ *        bit 0 - 15 is the hold count merged into it
+ */
+#define MULTI_BUTTON_HOLD_OPEN                (1U << 31)             /**< a queued hold takes the merged count */
+#define MULTI_BUTTON_HOLD_POS_MASK            (0x7FFFU)              /**< ring position mask */
+#define MULTI_BUTTON_HOLD_COUNT_MASK          (0xFFFFU)              /**< merged count mask */
 
 /**
  * @brief     set param
@@ -66,686 +87,2857 @@
  */
 static void a_multi_button_set_param(multi_button_handle_t *handle)
 {
-    handle->short_time = MULTI_BUTTON_SHORT_TIME;          /* set default short time */
-    handle->long_time = MULTI_BUTTON_LONG_TIME;            /* set default long time */
-    handle->repeat_time = MULTI_BUTTON_REPEAT_TIME;        /* set default repeat time */
-    handle->interval = MULTI_BUTTON_INTERVAL;              /* set default interval */
-    handle->timeout = MULTI_BUTTON_TIMEOUT;                /* set default timeout */
-    handle->repeat_cnt = MULTI_BUTTON_REPEAT_CNT;          /* set default repeat cnt */
-    handle->period = MULTI_BUTTON_PERIOD;                  /* set default period */
+    handle->short_time = MULTI_BUTTON_SHORT_TIME;                                /* set default short time */
+    handle->long_time = MULTI_BUTTON_LONG_TIME;                                  /* set default long time */
+    handle->repeat_time = MULTI_BUTTON_REPEAT_TIME;                              /* set default repeat time */
+    handle->interval = MULTI_BUTTON_INTERVAL;                                    /* set default interval */
+    handle->timeout = MULTI_BUTTON_TIMEOUT;                                      /* set default timeout */
+    handle->repeat_cnt = MULTI_BUTTON_REPEAT_CNT;                                /* set default repeat cnt */
+    handle->period = MULTI_BUTTON_PERIOD;                                        /* set default period */
+#if (MULTI_BUTTON_FEATURE_TYPEMATIC != 0)
+    handle->typematic = 0;                                                       /* disable typematic */
+    handle->typematic_delay = MULTI_BUTTON_TYPEMATIC_DELAY;                      /* set default typematic delay */
+    handle->typematic_interval = MULTI_BUTTON_TYPEMATIC_INTERVAL;                /* set default typematic interval */
+    handle->typematic_min_interval = MULTI_BUTTON_TYPEMATIC_MIN_INTERVAL;        /* set default typematic min interval */
+    handle->typematic_acceleration = MULTI_BUTTON_TYPEMATIC_ACCELERATION;        /* set default typematic acceleration */
+#endif
+#if (MULTI_BUTTON_FEATURE_CLICK != 0)
+    handle->speculative = 0;                                                     /* disable speculative */
+    handle->speculative_id = 0;                                                  /* init 0 */
+#endif
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+    handle->hold_interval = 0;                                                   /* coalesce no hold */
+    handle->coalesce_cnt = 0;                                                    /* init 0 */
+#endif
 }
 
 /**
- * @brief     reset all
+ * @brief     run the matrix_init hook
  * @param[in] *handle pointer to a multi_button handle structure
- * @param[in] row set row
- * @param[in] col set col
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
  * @note      none
  */
-static void a_multi_button_reset(multi_button_handle_t *handle, uint8_t row, uint8_t col)
+static uint8_t a_multi_button_matrix_init(multi_button_handle_t *handle)
 {
-    uint8_t res;
-    uint16_t offset;
-    multi_button_time_t t;
+    if (handle->matrix_init_ex != NULL)                        /* if ex linked */
+    {
+        return handle->matrix_init_ex(handle->user);           /* run with user */
+    }
     
-    offset = handle->col * row + col;                  /* get offset */
-    handle->button[offset].decode_len = 0;             /* reset the decode */
-    handle->button[offset].short_triggered = 0;        /* init 0 */
-    handle->button[offset].long_triggered = 0;         /* init 0 */
+    return handle->matrix_init();                              /* run */
+}
+
+/**
+ * @brief     run the matrix_deinit hook
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+static uint8_t a_multi_button_matrix_deinit(multi_button_handle_t *handle)
+{
+    if (handle->matrix_deinit_ex != NULL)                      /* if ex linked */
+    {
+        return handle->matrix_deinit_ex(handle->user);         /* run with user */
+    }
     
-    res = handle->timestamp_read(&t);                  /* timestamp read */
-    if (res != 0)                                      /* check result */
+    return handle->matrix_deinit();                            /* run */
+}
+
+/**
+ * @brief     run the matrix_write_row hook
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] num row number
+ * @param[in] level row level
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_multi_button_matrix_write_row(multi_button_handle_t *handle, uint16_t num, uint8_t level)
+{
+    if (handle->matrix_write_row_ex != NULL)                               /* if ex linked */
     {
-        return;                                        /* return error */
+        return handle->matrix_write_row_ex(handle->user, num, level);      /* run with user */
     }
-    handle->button[offset].last_time.s = t.s;          /* save last time */
-    handle->button[offset].last_time.us = t.us;        /* save last time */
+    
+    return handle->matrix_write_row(num, level);                           /* run */
 }
 
 /**
- * @brief     single period
+ * @brief     run the matrix_select_row hook
  * @param[in] *handle pointer to a multi_button handle structure
- * @param[in] row set row
- * @param[in] col set col
+ * @param[in] row selected row
  * @return    status code
  *            - 0 success
- *            - 1 run failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 check error
+ *            - 1 select failed
+ * @note      only called when matrix_select_row or matrix_select_row_ex is linked
+ */
+static uint8_t a_multi_button_matrix_select_row(multi_button_handle_t *handle, uint16_t row)
+{
+    if (handle->matrix_select_row_ex != NULL)                              /* if ex linked */
+    {
+        return handle->matrix_select_row_ex(handle->user, row);            /* run with user */
+    }
+    
+    return handle->matrix_select_row(row);                                 /* run */
+}
+
+/**
+ * @brief      run the matrix_read_row hook
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *col_array pointer to a col array buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_multi_button_matrix_read_row(multi_button_handle_t *handle, uint32_t *col_array)
+{
+    if (handle->matrix_read_row_ex != NULL)                                /* if ex linked */
+    {
+        return handle->matrix_read_row_ex(handle->user, col_array);        /* run with user */
+    }
+    
+    return handle->matrix_read_row(col_array);                             /* run */
+}
+
+/**
+ * @brief         run the matrix_read_row_timestamp hook
+ * @param[in]     *handle pointer to a multi_button handle structure
+ * @param[out]    *col_array pointer to a col array buffer
+ * @param[in,out] *t pointer to a col time array
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ * @note          only called when matrix_read_row_timestamp or matrix_read_row_timestamp_ex is linked
+ */
+static uint8_t a_multi_button_matrix_read_row_timestamp(multi_button_handle_t *handle, uint32_t *col_array,
+                                                        multi_button_time_t *t)
+{
+    if (handle->matrix_read_row_timestamp_ex != NULL)                      /* if ex linked */
+    {
+        return handle->matrix_read_row_timestamp_ex(handle->user,
+                                                    col_array, t);         /* run with user */
+    }
+    
+    return handle->matrix_read_row_timestamp(col_array, t);                /* run */
+}
+
+/**
+ * @brief     get the time diff
+ * @param[in] *now pointer to a now time structure
+ * @param[in] *last pointer to a last time structure
+ * @return    now - last in us
  * @note      none
  */
-static uint8_t a_multi_button_single_period(multi_button_handle_t *handle, uint8_t row, uint8_t col)
+static int64_t a_multi_button_diff_us(const multi_button_time_t *now, const multi_button_time_t *last)
+{
+    return ((int64_t)now->s - (int64_t)last->s) * 1000000 + 
+           ((int64_t)now->us - (int64_t)last->us);                /* now - last */
+}
+
+/**
+ * @brief         shift the time
+ * @param[in,out] *t pointer to a time structure
+ * @param[in]     us shifted time, negative moves the time backward
+ * @note          the result is clamped at zero
+ */
+static void a_multi_button_time_shift(multi_button_time_t *t, int64_t us)
+{
+    int64_t total;
+    
+    total = (int64_t)t->s * 1000000 + (int64_t)t->us + us;        /* shift */
+    if (total < 0)                                                 /* check the result */
+    {
+        total = 0;                                                 /* clamp at zero */
+    }
+    t->s = (uint64_t)(total / 1000000);                            /* set s */
+    t->us = (uint32_t)(total % 1000000);                           /* set us */
+}
+
+/**
+ * @brief     rebase the stored times after a backward clock step
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] us clock step in us, always negative
+ * @note      a forward step can not be told apart from elapsed time, use a monotonic clock source to avoid it
+ */
+static void a_multi_button_clock_step(multi_button_handle_t *handle, int64_t us)
+{
+    uint32_t i;
+    uint32_t num;
+    multi_button_single_t *button;
+    
+    handle->clock_step_cnt++;                                                      /* count the step */
+    handle->debug_print("multi_button: clock stepped backward %lld us.\n",
+                        (long long)(-us));                                         /* clock stepped backward */
+    a_multi_button_time_shift(&handle->check_time, us);                            /* shift check time */
+    num = (uint32_t)handle->row * handle->col;                                     /* get the button number */
+    for (i = 0; i < num; i++)                                                      /* loop all buttons */
+    {
+        button = &handle->button[i];                                               /* get the button */
+        a_multi_button_time_shift(&button->last_time, us);                         /* shift last time */
+        a_multi_button_time_shift(&button->press_time, us);                        /* shift press time */
+        a_multi_button_time_shift(&button->edge_time, us);                         /* shift edge time */
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+        a_multi_button_time_shift(&button->hold_time, us);                         /* shift hold time */
+#endif
+#if (MULTI_BUTTON_FEATURE_TYPEMATIC != 0)
+        a_multi_button_time_shift(&button->typematic_time, us);                    /* shift typematic time */
+#endif
+    }
+}
+
+/**
+ * @brief      run the timestamp_read hook
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *t pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_multi_button_timestamp_read(multi_button_handle_t *handle, multi_button_time_t *t)
 {
     uint8_t res;
-    uint16_t i;
-    uint16_t len;
-    uint16_t offset;
     int64_t diff;
-    multi_button_time_t t;
     
-    offset = handle->col * row + col;                                                                           /* get offset */
-    if (handle->button[offset].decode_len != 0)                                                                 /* if decode len is not 0 */
+    if (handle->timestamp_read_ex != NULL)                                 /* if ex linked */
     {
-        res = handle->timestamp_read(&t);                                                                       /* timestamp read */
-        if (res != 0)                                                                                           /* check result */
+        res = handle->timestamp_read_ex(handle->user, t);                  /* run with user */
+    }
+    else
+    {
+        res = handle->timestamp_read(t);                                   /* run */
+    }
+    if (res != 0)                                                          /* check result */
+    {
+        return res;                                                        /* return error */
+    }
+    diff = a_multi_button_diff_us(t, &handle->last_timestamp);             /* now - last timestamp */
+    if (diff < 0)                                                          /* clock stepped backward */
+    {
+        a_multi_button_clock_step(handle, diff);                           /* rebase the stored times */
+    }
+    handle->last_timestamp.s = t->s;                                       /* save the current s */
+    handle->last_timestamp.us = t->us;                                     /* save the current us */
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief     run the delay_ms hook
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_multi_button_delay_ms(multi_button_handle_t *handle, uint32_t ms)
+{
+    if (handle->delay_ms_ex != NULL)                        /* if ex linked */
+    {
+        handle->delay_ms_ex(handle->user, ms);              /* run with user */
+        
+        return;                                             /* return */
+    }
+    
+    handle->delay_ms(ms);                                   /* run */
+}
+
+#if (MULTI_BUTTON_FEATURE_TYPEMATIC != 0)
+
+/**
+ * @brief         add us to the time
+ * @param[in,out] *t pointer to a time structure
+ * @param[in]     us added time
+ * @note          none
+ */
+static void a_multi_button_time_add(multi_button_time_t *t, uint32_t us)
+{
+    uint64_t total;
+    
+    total = (uint64_t)t->us + us;                /* add us */
+    t->s += total / 1000000;                     /* carry s */
+    t->us = (uint32_t)(total % 1000000);         /* set us */
+}
+
+#endif
+
+/**
+ * @brief      fill an event record
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[in]  row set row
+ * @param[in]  col set col
+ * @param[in]  status event status
+ * @param[in]  times event times
+ * @param[in]  *t pointer to the event time structure
+ * @param[out] *event pointer to an event structure
+ * @note       none
+ */
+static void a_multi_button_event_fill(multi_button_handle_t *handle, uint8_t row, uint8_t col,
+                                      uint16_t status, uint16_t times, const multi_button_time_t *t,
+                                      multi_button_event_t *event)
+{
+    uint16_t offset;
+    
+    offset = handle->col * row + col;                                                        /* get offset */
+    event->t.s = t->s;                                                                       /* set s */
+    event->t.us = t->us;                                                                     /* set us */
+    if (status == MULTI_BUTTON_STATUS_PRESS)                                                 /* press */
+    {
+        event->duration_us = 0;                                                              /* no duration */
+    }
+    else if ((status & (MULTI_BUTTON_STATUS_SHORT_PRESS_START |
+                        MULTI_BUTTON_STATUS_LONG_PRESS_START |
+                        MULTI_BUTTON_STATUS_LONG_PRESS_HOLD |
+                        MULTI_BUTTON_STATUS_TYPEMATIC)) != 0)                                /* still holding */
+    {
+        event->duration_us = (uint32_t)a_multi_button_diff_us(t, 
+                             &handle->button[offset].press_time);                            /* hold duration */
+    }
+    else
+    {
+        event->duration_us = handle->button[offset].hold_us;                                 /* last press duration */
+    }
+    event->seq = handle->seq++;                                                              /* set sequence number */
+    event->index = offset;                                                                   /* set index */
+    event->row = row;                                                                        /* set row */
+    event->col = col;                                                                        /* set col */
+    event->status = status;                                                                  /* set status */
+    event->times = times;                                                                    /* set times */
+#if (MULTI_BUTTON_FEATURE_CLICK != 0)
+    event->id = handle->button[offset].speculative_id;                                       /* set speculative id */
+#else
+    event->id = 0;                                                                           /* no speculative id */
+#endif
+}
+
+#if (MULTI_BUTTON_EVENT_RING_SIZE > 0)
+/**
+ * @brief     push an event to the event ring
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] *event pointer to an event structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 ring is full
+ * @note      only called by the scan, the tail is never written here,
+ *            with the oldest drop policy a full ring overwrites the oldest unread slot
+ */
+static uint8_t a_multi_button_event_push(multi_button_handle_t *handle, const multi_button_event_t *event)
+{
+    uint32_t i;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t word[sizeof(handle->event_ring[0].word) / sizeof(uint32_t)];
+    multi_button_event_slot_t *slot;
+    
+    head = atomic_load_explicit(&handle->event_head, memory_order_relaxed);                 /* get head */
+    tail = atomic_load_explicit(&handle->event_tail, memory_order_acquire);                 /* get tail */
+    if (((uint32_t)(head - tail) >= MULTI_BUTTON_EVENT_RING_SIZE) &&
+        (handle->event_policy != MULTI_BUTTON_OVERFLOW_DROP_OLDEST))                        /* full and drop newest */
+    {
+        atomic_fetch_add_explicit(&handle->event_overflow, 1, memory_order_relaxed);        /* overflow++ */
+        
+        return 1;                                                                           /* drop */
+    }
+    slot = &handle->event_ring[head & (MULTI_BUTTON_EVENT_RING_SIZE - 1)];                  /* get the slot */
+    memcpy(word, event, sizeof(multi_button_event_t));                                      /* copy to words */
+    atomic_store_explicit(&slot->seq, head, memory_order_relaxed);                          /* mark the new position */
+    atomic_thread_fence(memory_order_release);                                              /* seq before the words */
+    for (i = 0; i < sizeof(word) / sizeof(uint32_t); i++)                                   /* loop all words */
+    {
+        atomic_store_explicit(&slot->word[i], word[i], memory_order_relaxed);               /* store the word */
+    }
+    atomic_store_explicit(&handle->event_head, head + 1, memory_order_release);             /* publish */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief      read an event from an event ring slot
+ * @param[in]  *slot pointer to an event ring slot
+ * @param[in]  pos expected ring position
+ * @param[out] *event pointer to an event buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 the slot is overwritten
+ * @note       only called by the consumer
+ */
+static uint8_t a_multi_button_event_read(multi_button_event_slot_t *slot, uint32_t pos, multi_button_event_t *event)
+{
+    uint32_t i;
+    uint32_t word[sizeof(slot->word) / sizeof(uint32_t)];
+    
+    if (atomic_load_explicit(&slot->seq, memory_order_acquire) != pos)                      /* check the position */
+    {
+        return 1;                                                                           /* overwritten */
+    }
+    for (i = 0; i < sizeof(word) / sizeof(uint32_t); i++)                                   /* loop all words */
+    {
+        word[i] = atomic_load_explicit(&slot->word[i], memory_order_relaxed);               /* load the word */
+    }
+    atomic_thread_fence(memory_order_acquire);                                              /* words before the seq */
+    if (atomic_load_explicit(&slot->seq, memory_order_relaxed) != pos)                      /* check the position again */
+    {
+        return 1;                                                                           /* overwritten while reading */
+    }
+    memcpy(event, word, sizeof(multi_button_event_t));                                      /* copy the event */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+/**
+ * @brief     close the queued hold of a key
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] offset button offset
+ * @return    the hold count merged into the queued hold and not taken by the consumer
+ * @note      only called by the scan
+ */
+static uint16_t a_multi_button_hold_close(multi_button_handle_t *handle, uint16_t offset)
+{
+    uint32_t merge;
+    
+    merge = atomic_exchange_explicit(&handle->button[offset].hold_merge, 0,
+                                     memory_order_acq_rel);                                 /* close */
+    if ((merge & MULTI_BUTTON_HOLD_OPEN) == 0)                                              /* check open */
+    {
+        return 0;                                                                           /* taken by the consumer */
+    }
+    
+    return (uint16_t)(merge & MULTI_BUTTON_HOLD_COUNT_MASK);                                /* return the count */
+}
+
+/**
+ * @brief         take the hold count merged into a popped hold
+ * @param[in]     *handle pointer to a multi_button handle structure
+ * @param[in,out] *event pointer to a hold event
+ * @param[in]     pos ring position of the event
+ * @note          only called by the consumer, no more holds are merged into the event after this
+ */
+static void a_multi_button_hold_take(multi_button_handle_t *handle, multi_button_event_t *event, uint32_t pos)
+{
+    uint32_t sum;
+    uint32_t merge;
+    _Atomic uint32_t *word;
+    
+    word = &handle->button[event->index].hold_merge;                                        /* get the merge word */
+    merge = atomic_load_explicit(word, memory_order_acquire);                               /* get the merge word */
+    while (((merge & MULTI_BUTTON_HOLD_OPEN) != 0) &&
+           (((merge >> 16) & MULTI_BUTTON_HOLD_POS_MASK) == (pos & MULTI_BUTTON_HOLD_POS_MASK)))    /* open for this event */
+    {
+        if (atomic_compare_exchange_weak_explicit(word, &merge, 0, memory_order_acq_rel,
+                                                  memory_order_acquire))                    /* close */
         {
-            handle->debug_print("multi_button: timestamp read failed.\n");                                      /* timestamp read failed */
+            sum = (uint32_t)event->times + (merge & MULTI_BUTTON_HOLD_COUNT_MASK);           /* add the merged count */
+            event->times = (uint16_t)((sum > 0xFFFF) ? 0xFFFF : sum);                       /* set times */
             
-            return 1;                                                                                           /* return error */
+            return;                                                                         /* return */
         }
-        if (handle->button[offset].decode_len == 1)                                                             /* short or long press */
+    }
+}
+#endif
+#endif
+
+#if (MULTI_BUTTON_BATCH_LENGTH > 0)
+/**
+ * @brief     deliver the batched events
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @note      none
+ */
+static void a_multi_button_batch_flush(multi_button_handle_t *handle)
+{
+    if (handle->batch_len != 0)                                                                        /* if not empty */
+    {
+        handle->receive_batch_callback(handle->user, handle->batch, (size_t)handle->batch_len);        /* run the batch callback */
+        handle->batch_len = 0;                                                                         /* clear the batch */
+    }
+}
+#endif
+
+#if (MULTI_BUTTON_SUBSCRIBER_NUMBER > 0)
+/**
+ * @brief     get the bit index of a status
+ * @param[in] status event status with one bit set
+ * @return    bit index
+ * @note      none
+ */
+static uint8_t a_multi_button_status_bit(uint16_t status)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint8_t)__builtin_ctz(status);                                         /* count the trailing zeros */
+#else
+    static const uint8_t gs_debruijn[32] =
+    {
+        0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+        31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9,
+    };
+    
+    return gs_debruijn[((uint32_t)status * 0x077CB531U) >> 27];                   /* de bruijn mapping */
+#endif
+}
+
+/**
+ * @brief     run the subscribers
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] subscriber subscriber mask
+ * @param[in] *event pointer to an event structure
+ * @note      none
+ */
+static void a_multi_button_dispatch(multi_button_handle_t *handle, uint32_t subscriber, const multi_button_event_t *event)
+{
+    uint8_t i;
+    
+    for (i = 0; subscriber != 0; i++, subscriber >>= 1)                                 /* loop all subscribers */
+    {
+        if (((subscriber & 0x01) != 0) && (handle->subscriber[i].handler != NULL))       /* if subscribed */
         {
-            diff = (int64_t)(t.s - handle->button[offset].decode[0].t.s) * 1000000 + 
-                   (int64_t)(t.us - handle->button[offset].decode[0].t.us) ;                                    /* now - last time */
-            if ((uint32_t)(diff) >= handle->short_time)                                                         /* check short time */
-            {
-                if (handle->button[offset].short_triggered == 0)                                                /* if no triggered */
-                {
-                    multi_button_t multi_button;
-                    
-                    multi_button.status = MULTI_BUTTON_STATUS_SHORT_PRESS_START;                                /* short press start */
-                    multi_button.times = 0;                                                                     /* 0 times */
-                    handle->receive_callback(row, col, &multi_button);                                          /* run the reception callback */
-                    handle->button[offset].short_triggered = 1;                                                 /* set triggered */
-                }
-            }
-            if ((uint32_t)(diff) >= handle->long_time)                                                          /* check long time */
-            {
-                if (handle->button[offset].long_triggered == 0)                                                 /* if no triggered */
-                {
-                    multi_button_t multi_button;
-                    
-                    multi_button.status = MULTI_BUTTON_STATUS_LONG_PRESS_START;                                 /* long press start */
-                    multi_button.times = 0;                                                                     /* 0 times */
-                    handle->receive_callback(row, col, &multi_button);                                          /* run the reception callback */
-                    handle->button[offset].long_triggered = 1;                                                  /* set triggered */
-                }
-                else
-                {
-                    multi_button_t multi_button;
-                    
-                    multi_button.status = MULTI_BUTTON_STATUS_LONG_PRESS_HOLD;                                  /* long press hold */
-                    multi_button.times = 0;                                                                     /* 0 times */
-                    handle->receive_callback(row, col, &multi_button);                                          /* run the reception callback */
-                }
-            }
+            handle->subscriber[i].handler(handle->subscriber[i].ctx, event);             /* run the handler */
         }
-        else if (handle->button[offset].decode_len == 2)                                                        /* single click, short or long press */
+    }
+}
+#endif
+
+/**
+ * @brief     emit an event
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] row set row
+ * @param[in] col set col
+ * @param[in] status event status
+ * @param[in] times event times
+ * @param[in] *t pointer to the event time structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 the event is masked or dropped by the event ring
+ * @note      none
+ */
+static uint8_t a_multi_button_emit(multi_button_handle_t *handle, uint8_t row, uint8_t col,
+                                   uint16_t status, uint16_t times, const multi_button_time_t *t)
+{
+    uint16_t offset;
+    uint32_t subscriber;
+    multi_button_t multi_button;
+    multi_button_event_t event;
+    multi_button_event_t *e;
+    
+    offset = handle->col * row + col;                                                        /* get offset */
+    if ((handle->button[offset].gesture & status) == 0)                                      /* check the gesture mask */
+    {
+        return 1;                                                                            /* disabled */
+    }
+#if (MULTI_BUTTON_EVENT_RING_SIZE > 0)
+    if (handle->event_ring_enable != 0)                                                      /* if ring enabled */
+    {
+        a_multi_button_event_fill(handle, row, col, status, times, t, &event);               /* fill event */
+        
+        return a_multi_button_event_push(handle, &event);                                    /* enqueue only */
+    }
+#endif
+#if (MULTI_BUTTON_SUBSCRIBER_NUMBER > 0)
+    subscriber = handle->button[offset].subscriber &
+                 handle->subscriber_status[a_multi_button_status_bit(status)];               /* get the subscribers */
+#else
+    subscriber = 0;                                                                          /* no subscriber */
+#endif
+    e = &event;                                                                              /* use the local event */
+#if (MULTI_BUTTON_BATCH_LENGTH > 0)
+    if (handle->receive_batch_callback != NULL)                                              /* if batch linked */
+    {
+        e = &handle->batch[handle->batch_len];                                               /* use the batch slot */
+    }
+#endif
+    if ((subscriber != 0) ||
+#if (MULTI_BUTTON_BATCH_LENGTH > 0)
+        (handle->receive_batch_callback != NULL) ||
+#endif
+        (handle->receive_event_callback != NULL))                                            /* if the record is used */
+    {
+        a_multi_button_event_fill(handle, row, col, status, times, t, e);                    /* fill event */
+    }
+#if (MULTI_BUTTON_SUBSCRIBER_NUMBER > 0)
+    a_multi_button_dispatch(handle, subscriber, e);                                          /* run the subscribers */
+#endif
+#if (MULTI_BUTTON_BATCH_LENGTH > 0)
+    if (handle->receive_batch_callback != NULL)                                              /* if batch linked */
+    {
+        handle->batch_len++;                                                                 /* len++ */
+        if (handle->batch_len >= MULTI_BUTTON_BATCH_LENGTH)                                  /* check full */
         {
-            diff = (int64_t)(t.s - handle->button[offset].decode[1].t.s) * 1000000 + 
-                   (int64_t)(t.us - handle->button[offset].decode[1].t.us) ;                                    /* now - last time */
-            if (handle->button[offset].long_triggered != 0)                                                     /* if long no triggered */
-            {
-                multi_button_t multi_button;
-                
-                multi_button.status = MULTI_BUTTON_STATUS_LONG_PRESS_END;                                       /* long press end */
-                multi_button.times = 0;                                                                         /* 0 times */
-                handle->receive_callback(row, col, &multi_button);                                              /* run the reception callback */
-                a_multi_button_reset(handle, row, col);                                                         /* reset all */
-            }
-            else if (handle->button[offset].short_triggered != 0)                                               /* if short no triggered */
+            a_multi_button_batch_flush(handle);                                              /* flush early */
+        }
+        
+        return 0;                                                                            /* success return 0 */
+    }
+#endif
+    if (handle->receive_event_callback != NULL)                                              /* if not null */
+    {
+        handle->receive_event_callback(handle->user, e);                                     /* run the event callback */
+    }
+    if ((handle->receive_callback_ex != NULL) || (handle->receive_callback != NULL))         /* if not null */
+    {
+        multi_button.status = status;                                                        /* set status */
+        multi_button.times = times;                                                          /* set times */
+#if (MULTI_BUTTON_FEATURE_CLICK != 0)
+        multi_button.id = handle->button[offset].speculative_id;                             /* set speculative id */
+#else
+        multi_button.id = 0;                                                                 /* no speculative id */
+#endif
+        if (handle->receive_callback_ex != NULL)                                             /* if ex linked */
+        {
+            handle->receive_callback_ex(handle->user, row, col, &multi_button);              /* run with user */
+        }
+        else
+        {
+            handle->receive_callback(row, col, &multi_button);                               /* run the reception callback */
+        }
+    }
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     reset all
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] row set row
+ * @param[in] col set col
+ * @param[in] *t pointer to a now time structure
+ * @note      none
+ */
+static void a_multi_button_reset(multi_button_handle_t *handle, uint8_t row, uint8_t col, const multi_button_time_t *t)
+{
+    uint16_t offset;
+    
+    offset = handle->col * row + col;                                                      /* get offset */
+#if (MULTI_BUTTON_FEATURE_CLICK != 0)
+    if (handle->button[offset].speculative_id != 0)                                        /* if speculative pending */
+    {
+        a_multi_button_emit(handle, row, col, MULTI_BUTTON_STATUS_CLICK_RETRACT, 0, t);    /* retract */
+        handle->button[offset].speculative_id = 0;                                         /* clear id */
+    }
+#endif
+    handle->button[offset].times = 0;                                                      /* reset the times */
+    handle->button[offset].pressed = 0;                                                    /* reset the pressed */
+#if (MULTI_BUTTON_FEATURE_SHORT_PRESS != 0)
+    handle->button[offset].short_triggered = 0;                                            /* init 0 */
+#endif
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+    handle->button[offset].long_triggered = 0;                                             /* init 0 */
+#endif
+    handle->button[offset].last_time.s = t->s;                                             /* save last time */
+    handle->button[offset].last_time.us = t->us;                                           /* save last time */
+}
+
+#if (MULTI_BUTTON_FEATURE_CLICK != 0)
+
+/**
+ * @brief     get the click limit of a button
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] offset button offset
+ * @return    max click times, 0 means no limit
+ * @note      none
+ */
+static uint16_t a_multi_button_click_limit(multi_button_handle_t *handle, uint16_t offset)
+{
+    uint16_t limit;
+    uint16_t gesture;
+    
+    gesture = handle->button[offset].gesture;                                             /* get gesture */
+    if ((gesture & MULTI_BUTTON_MULTI_CLICK_MASK) == 0)                                   /* no multi click */
+    {
+        return 1;                                                                         /* only single click */
+    }
+    if ((gesture & (MULTI_BUTTON_STATUS_TRIPLE_CLICK | 
+                    MULTI_BUTTON_STATUS_REPEAT_CLICK)) == 0)                              /* no triple and repeat click */
+    {
+        limit = 2;                                                                        /* up to double click */
+    }
+    else if ((gesture & MULTI_BUTTON_STATUS_REPEAT_CLICK) == 0)                           /* no repeat click */
+    {
+        limit = 3;                                                                        /* up to triple click */
+    }
+    else
+    {
+        limit = 0;                                                                        /* no limit */
+    }
+    if ((handle->button[offset].max_click != 0) &&
+        ((limit == 0) || (handle->button[offset].max_click < limit)))                     /* check max click */
+    {
+        limit = handle->button[offset].max_click;                                         /* set max click */
+    }
+    
+    return limit;                                                                         /* return limit */
+}
+
+/**
+ * @brief     emit a click event
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] row set row
+ * @param[in] col set col
+ * @param[in] times click times
+ * @param[in] *t pointer to a now time structure
+ * @note      resolve the pending speculative click before the click event
+ */
+static void a_multi_button_emit_click(multi_button_handle_t *handle, uint8_t row, uint8_t col,
+                                      uint16_t times, const multi_button_time_t *t)
+{
+    uint16_t offset;
+    
+    offset = handle->col * row + col;                                                          /* get offset */
+    if (handle->button[offset].speculative_id != 0)                                            /* if speculative pending */
+    {
+        if (times == 1)                                                                        /* 1 times */
+        {
+            a_multi_button_emit(handle, row, col, MULTI_BUTTON_STATUS_CLICK_CONFIRM, 1, t);    /* confirm */
+        }
+        else
+        {
+            a_multi_button_emit(handle, row, col, 
+                                MULTI_BUTTON_STATUS_CLICK_UPGRADE, times, t);                  /* upgrade */
+        }
+    }
+    if (times == 1)                                                                            /* 1 times */
+    {
+        a_multi_button_emit(handle, row, col, MULTI_BUTTON_STATUS_SINGLE_CLICK, 1, t);         /* single click */
+    }
+    else if (times == 2)                                                                       /* 2 times */
+    {
+        a_multi_button_emit(handle, row, col, MULTI_BUTTON_STATUS_DOUBLE_CLICK, 2, t);         /* double click */
+    }
+    else if (times == 3)                                                                       /* 3 times */
+    {
+        a_multi_button_emit(handle, row, col, MULTI_BUTTON_STATUS_TRIPLE_CLICK, 3, t);         /* triple click */
+    }
+    else
+    {
+        a_multi_button_emit(handle, row, col, MULTI_BUTTON_STATUS_REPEAT_CLICK, times, t);     /* repeat click */
+    }
+    handle->button[offset].speculative_id = 0;                                                 /* resolved */
+}
+
+#endif
+
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+
+/**
+ * @brief     long press hold
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] row set row
+ * @param[in] col set col
+ * @param[in] *t pointer to a now time structure
+ * @note      holds inside the min interval are coalesced into the next hold event,
+ *            with the ring coalescing a hold is merged into the queued hold of the key until it is popped,
+ *            times of a hold event is the number of the other holds coalesced into it
+ */
+static void a_multi_button_hold(multi_button_handle_t *handle, uint8_t row, uint8_t col, const multi_button_time_t *t)
+{
+    uint16_t offset;
+    uint16_t times;
+#if (MULTI_BUTTON_EVENT_RING_SIZE > 0)
+    uint32_t head;
+    uint32_t merge;
+    uint32_t sum;
+#endif
+    
+    offset = handle->col * row + col;                                                           /* get offset */
+    if (handle->button[offset].hold_times < 0xFFFF)                                             /* check the max times */
+    {
+        handle->button[offset].hold_times++;                                                    /* times++ */
+    }
+    if ((handle->hold_interval != 0) &&
+        ((uint32_t)a_multi_button_diff_us(t, &handle->button[offset].hold_time) <
+         handle->hold_interval))                                                                /* check the min interval */
+    {
+        handle->coalesce_cnt++;                                                                 /* coalesced */
+        
+        return;                                                                                 /* return */
+    }
+#if (MULTI_BUTTON_EVENT_RING_SIZE > 0)
+    if ((handle->hold_coalesce != 0) && (handle->event_ring_enable != 0))                       /* if coalesce in the ring */
+    {
+        head = atomic_load_explicit(&handle->event_head, memory_order_relaxed);                 /* get head, only written here */
+        merge = atomic_load_explicit(&handle->button[offset].hold_merge, memory_order_acquire); /* get the merge word */
+        if (((merge & MULTI_BUTTON_HOLD_OPEN) != 0) &&
+            ((uint32_t)(head - handle->button[offset].hold_pos) > MULTI_BUTTON_EVENT_RING_SIZE)) /* queued hold is overwritten */
+        {
+            sum = (uint32_t)handle->button[offset].hold_times +
+                  a_multi_button_hold_close(handle, offset);                                    /* carry the merged count */
+            handle->button[offset].hold_times = (uint16_t)((sum > 0xFFFF) ? 0xFFFF : sum);      /* set the hold times */
+            merge = 0;                                                                          /* closed */
+        }
+        while ((merge & MULTI_BUTTON_HOLD_OPEN) != 0)                                           /* queued hold is not popped */
+        {
+            sum = (merge & MULTI_BUTTON_HOLD_COUNT_MASK) + handle->button[offset].hold_times;   /* merge the count */
+            if (sum > 0xFFFF)                                                                   /* check the max times */
             {
-                multi_button_t multi_button;
-                
-                multi_button.status = MULTI_BUTTON_STATUS_SHORT_PRESS_END;                                      /* long press end */
-                multi_button.times = 0;                                                                         /* 0 times */
-                handle->receive_callback(row, col, &multi_button);                                              /* run the reception callback */
-                a_multi_button_reset(handle, row, col);                                                         /* reset all */
+                sum = 0xFFFF;                                                                   /* saturate */
             }
-            else
+            if (atomic_compare_exchange_weak_explicit(&handle->button[offset].hold_merge, &merge,
+                                                      (merge & ~MULTI_BUTTON_HOLD_COUNT_MASK) | sum,
+                                                      memory_order_acq_rel,
+                                                      memory_order_acquire))                    /* merge into the queued hold */
             {
-                if ((uint32_t)(diff) >= handle->repeat_time)                                                    /* check repeat time */
-                {
-                    multi_button_t multi_button;
-                    
-                    multi_button.status = MULTI_BUTTON_STATUS_SINGLE_CLICK;                                     /* single click */
-                    multi_button.times = 1;                                                                     /* 1 times */
-                    handle->receive_callback(row, col, &multi_button);                                          /* run the reception callback */
-                    a_multi_button_reset(handle, row, col);                                                     /* reset all */
-                }
+                handle->button[offset].hold_times = 0;                                          /* init 0 */
+                handle->coalesce_cnt++;                                                         /* coalesced */
+                
+                return;                                                                         /* return */
             }
         }
-        else if (handle->button[offset].decode_len == 4)                                                        /* double click */
+        atomic_store_explicit(&handle->button[offset].hold_merge,
+                              MULTI_BUTTON_HOLD_OPEN | ((head & MULTI_BUTTON_HOLD_POS_MASK) << 16),
+                              memory_order_relaxed);                                            /* open, published by the head */
+        handle->button[offset].hold_pos = head;                                                 /* save the ring position */
+        times = handle->button[offset].hold_times - 1;                                          /* set the coalesced times */
+        handle->button[offset].hold_times = 0;                                                  /* init 0 */
+        handle->button[offset].hold_time.s = t->s;                                              /* save hold s */
+        handle->button[offset].hold_time.us = t->us;                                            /* save hold us */
+        if (a_multi_button_emit(handle, row, col, MULTI_BUTTON_STATUS_LONG_PRESS_HOLD,
+                                times, t) != 0)                                                 /* long press hold */
         {
-            diff = (int64_t)(t.s - handle->button[offset].last_time.s) * 1000000 + 
-                   (int64_t)(t.us - handle->button[offset].last_time.us) ;                                      /* now - last time */
-            if ((uint32_t)(diff) >= handle->repeat_time)                                                        /* check repeat time */
-            {
-                multi_button_t multi_button;
-                
-                len = handle->button[offset].decode_len - 1;                                                    /* len - 1 */
-                for (i = 0; i < len; i++)                                                                       /* diff all time */
-                {
-                    int64_t diff2;
-                    
-                    diff2 = (int64_t)((int64_t)handle->button[offset].decode[i + 1].t.s -
-                            (int64_t)handle->button[offset].decode[i].t.s) * 1000000 + 
-                            (int64_t)((int64_t)handle->button[offset].decode[i + 1].t.us -
-                            (int64_t)handle->button[offset].decode[i].t.us);                                    /* diff time */
-                    handle->button[offset].decode[i].diff_us = (uint32_t)diff2;                                 /* save the time diff2 */
-                }
-                handle->button[offset].decode[3].diff_us = (uint32_t)diff;                                      /* save the time diff */
-                
-                for (i = 1; i < len; i += 2)                                                                    /* check decode length */
-                {
-                    if (handle->button[offset].decode[i].diff_us >= handle->repeat_time)                        /* check repeat time */
-                    {
-                        handle->debug_print("multi_button: double click error.\n");                             /* double click error */
-                        a_multi_button_reset(handle, row, col);                                                 /* reset all */
-                        
-                        return 4;                                                                               /* return error */
-                    }
-                }
-                
-                multi_button.status = MULTI_BUTTON_STATUS_DOUBLE_CLICK;                                         /* double click */
-                multi_button.times = 2;                                                                         /* 2 times */
-                handle->receive_callback(row, col, &multi_button);                                              /* run the reception callback */
-                a_multi_button_reset(handle, row, col);                                                         /* reset all */
-            }
+            atomic_store_explicit(&handle->button[offset].hold_merge, 0, memory_order_relaxed); /* not queued, nothing to merge into */
+        }
+        
+        return;                                                                                 /* return */
+    }
+#endif
+    times = handle->button[offset].hold_times - 1;                                              /* set the coalesced times */
+    handle->button[offset].hold_times = 0;                                                      /* init 0 */
+    handle->button[offset].hold_time.s = t->s;                                                  /* save hold s */
+    handle->button[offset].hold_time.us = t->us;                                                /* save hold us */
+    a_multi_button_emit(handle, row, col, MULTI_BUTTON_STATUS_LONG_PRESS_HOLD, times, t);       /* long press hold */
+}
+
+/**
+ * @brief     report the pending holds at the release
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] row set row
+ * @param[in] col set col
+ * @param[in] *t pointer to the release time structure
+ * @note      the holds coalesced by the min interval or merged into a hold still in the ring are reported
+ *            in one hold event before the release event
+ */
+static void a_multi_button_hold_flush(multi_button_handle_t *handle, uint8_t row, uint8_t col, const multi_button_time_t *t)
+{
+    uint16_t offset;
+    uint32_t times;
+    
+    offset = handle->col * row + col;                                                           /* get offset */
+    times = handle->button[offset].hold_times;                                                  /* get the pending times */
+#if (MULTI_BUTTON_EVENT_RING_SIZE > 0)
+    times += a_multi_button_hold_close(handle, offset);                                         /* take back the merged count */
+#endif
+    handle->button[offset].hold_times = 0;                                                      /* init 0 */
+    if (times != 0)                                                                             /* check the pending times */
+    {
+        a_multi_button_emit(handle, row, col, MULTI_BUTTON_STATUS_LONG_PRESS_HOLD,
+                            (uint16_t)((times > 0x10000) ? 0xFFFF : (times - 1)), t);           /* long press hold */
+    }
+}
+
+#endif
+
+/**
+ * @brief     finish the gesture at the release
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] row set row
+ * @param[in] col set col
+ * @param[in] times click times
+ * @param[in] *t pointer to a now time structure
+ * @note      none
+ */
+static void a_multi_button_single_finish(multi_button_handle_t *handle, uint8_t row, uint8_t col,
+                                         uint16_t times, const multi_button_time_t *t)
+{
+#if (MULTI_BUTTON_FEATURE_SHORT_PRESS != 0) || (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+    uint16_t offset;
+    
+    offset = handle->col * row + col;                                                         /* get offset */
+#endif
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+    if (handle->button[offset].long_triggered != 0)                                           /* if long triggered */
+    {
+        a_multi_button_emit(handle, row, col, MULTI_BUTTON_STATUS_LONG_PRESS_END, 0, t);      /* long press end */
+    }
+    else
+#endif
+#if (MULTI_BUTTON_FEATURE_SHORT_PRESS != 0)
+    if (handle->button[offset].short_triggered != 0)                                          /* if short triggered */
+    {
+        a_multi_button_emit(handle, row, col, MULTI_BUTTON_STATUS_SHORT_PRESS_END, 0, t);     /* short press end */
+    }
+    else
+#endif
+    {
+#if (MULTI_BUTTON_FEATURE_CLICK != 0)
+        a_multi_button_emit_click(handle, row, col, times, t);                                /* click */
+#else
+        (void)times;                                                                          /* no click */
+#endif
+    }
+    a_multi_button_reset(handle, row, col, t);                                                /* reset all */
+}
+
+/**
+ * @brief     single period
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] row set row
+ * @param[in] col set col
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 check error
+ * @note      none
+ */
+static uint8_t a_multi_button_single_period(multi_button_handle_t *handle, uint8_t row, uint8_t col)
+{
+    uint8_t res;
+    uint16_t offset;
+    int64_t diff;
+    multi_button_time_t t;
+    
+    offset = handle->col * row + col;                                                                           /* get offset */
+    if (handle->button[offset].times != 0)                                                                      /* if in a gesture */
+    {
+        res = a_multi_button_timestamp_read(handle, &t);                                                        /* timestamp read */
+        if (res != 0)                                                                                           /* check result */
+        {
+            handle->debug_print("multi_button: timestamp read failed.\n");                                     /* timestamp read failed */
+            
+            return 1;                                                                                           /* return error */
         }
-        else if (handle->button[offset].decode_len == 6)                                                        /* triple click */
+        diff = a_multi_button_diff_us(&t, &handle->button[offset].last_time);                                   /* now - last time */
+        if (handle->button[offset].pressed != 0)                                                                /* if pressed */
         {
-            diff = (int64_t)(t.s - handle->button[offset].last_time.s) * 1000000 + 
-                   (int64_t)(t.us - handle->button[offset].last_time.us) ;                                      /* now - last time */
-            if ((uint32_t)(diff) >= handle->repeat_time)                                                        /* check repeat time */
+            if (handle->button[offset].times == 1)                                                              /* short or long press */
             {
-                multi_button_t multi_button;
-                
-                len = handle->button[offset].decode_len - 1;                                                    /* len - 1 */
-                for (i = 0; i < len; i++)                                                                       /* diff all time */
+#if (MULTI_BUTTON_FEATURE_SHORT_PRESS != 0)
+                if ((uint32_t)(diff) >= handle->short_time)                                                     /* check short time */
                 {
-                    int64_t diff2;
-                    
-                    diff2 = (int64_t)((int64_t)handle->button[offset].decode[i + 1].t.s -
-                            (int64_t)handle->button[offset].decode[i].t.s) * 1000000 + 
-                            (int64_t)((int64_t)handle->button[offset].decode[i + 1].t.us -
-                            (int64_t)handle->button[offset].decode[i].t.us);                                    /* diff time */
-                    handle->button[offset].decode[i].diff_us = (uint32_t)diff2;                                 /* save the time diff2 */
-                }
-                handle->button[offset].decode[5].diff_us = (uint32_t)diff;                                      /* save the time diff */
-                
-                for (i = 1; i < len; i += 2)                                                                    /* check decode length */
-                {
-                    if (handle->button[offset].decode[i].diff_us >= handle->repeat_time)                        /* check repeat time */
+                    if (handle->button[offset].short_triggered == 0)                                            /* if no triggered */
                     {
-                        handle->debug_print("multi_button: triple click error.\n");                             /* triple click error */
-                        a_multi_button_reset(handle, row, col);                                                 /* reset all */
-                        
-                        return 4;                                                                               /* return error */
+                        a_multi_button_emit(handle, row, col, MULTI_BUTTON_STATUS_SHORT_PRESS_START, 0, &t);    /* short press start */
+                        handle->button[offset].short_triggered = 1;                                             /* set triggered */
                     }
                 }
-                
-                multi_button.status = MULTI_BUTTON_STATUS_TRIPLE_CLICK;                                         /* triple click */
-                multi_button.times = 3;                                                                         /* 3 times */
-                handle->receive_callback(row, col, &multi_button);                                              /* run the reception callback */
-                a_multi_button_reset(handle, row, col);                                                         /* reset all */
-            }
-        }
-        else
-        {
-            if ((handle->button[offset].decode_len > 6) && (handle->button[offset].decode_len % 2 == 0))        /* check time */
-            {
-                diff = (int64_t)(t.s - handle->button[offset].last_time.s) * 1000000 + 
-                       (int64_t)(t.us - handle->button[offset].last_time.us) ;                                  /* now - last time */
-                if ((uint32_t)(diff) >= handle->repeat_time)                                                    /* check repeat time */
+#endif
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+                if ((uint32_t)(diff) >= handle->long_time)                                                      /* check long time */
                 {
-                    multi_button_t multi_button;
-                    
-                    len = handle->button[offset].decode_len - 1;                                                /* len - 1 */
-                    for (i = 0; i < len; i++)                                                                   /* diff all time */
+                    if (handle->button[offset].long_triggered == 0)                                             /* if no triggered */
                     {
-                        int64_t diff2;
-                        
-                        diff2 = (int64_t)((int64_t)handle->button[offset].decode[i + 1].t.s -
-                                (int64_t)handle->button[offset].decode[i].t.s) * 1000000 + 
-                                (int64_t)((int64_t)handle->button[offset].decode[i + 1].t.us -
-                                (int64_t)handle->button[offset].decode[i].t.us);                                /* diff time */
-                        handle->button[offset].decode[i].diff_us = (uint32_t)diff2;                             /* save the time diff2 */
+                        a_multi_button_emit(handle, row, col, MULTI_BUTTON_STATUS_LONG_PRESS_START, 0, &t);     /* long press start */
+                        handle->button[offset].long_triggered = 1;                                              /* set triggered */
+                        handle->button[offset].hold_time.s = t.s;                                               /* save hold s */
+                        handle->button[offset].hold_time.us = t.us;                                             /* save hold us */
+                        handle->button[offset].hold_times = 0;                                                  /* init 0 */
+#if (MULTI_BUTTON_EVENT_RING_SIZE > 0)
+                        (void)a_multi_button_hold_close(handle, offset);                                        /* no hold queued */
+#endif
                     }
-                    handle->button[offset].decode[len].diff_us = (uint32_t)diff;                                /* save the time diff */
-                    
-                    for (i = 1; i < len; i += 2)                                                                /* check decode length */
+                    else
                     {
-                        if (handle->button[offset].decode[i].diff_us >= handle->repeat_time)                    /* check repeat time */
-                        {
-                            handle->debug_print("multi_button: repeat click error.\n");                         /* repeat click error */
-                            a_multi_button_reset(handle, row, col);                                             /* reset all */
-                            
-                            return 4;                                                                           /* return error */
-                        }
+                        a_multi_button_hold(handle, row, col, &t);                                              /* long press hold */
                     }
-                    
-                    multi_button.status = MULTI_BUTTON_STATUS_REPEAT_CLICK;                                     /* repeat click */
-                    multi_button.times = handle->button[offset].decode_len / 2;                                 /* decode times */
-                    handle->receive_callback(row, col, &multi_button);                                          /* run the reception callback */
-                    a_multi_button_reset(handle, row, col);                                                     /* reset all */
                 }
+#endif
             }
             else
             {
-                diff = (int64_t)(t.s - handle->button[offset].last_time.s) * 1000000 + 
-                       (int64_t)(t.us - handle->button[offset].last_time.us) ;                                  /* now - last time */
                 if ((uint32_t)(diff) >= handle->timeout)                                                        /* check timeout */
                 {
                     handle->debug_print("multi_button: reset checking.\n");                                     /* reset checking */
-                    a_multi_button_reset(handle, row, col);                                                     /* reset all */
+                    a_multi_button_reset(handle, row, col, &t);                                                 /* reset all */
                     
                     return 4;                                                                                   /* return error */
                 }
             }
         }
+#if (MULTI_BUTTON_FEATURE_CLICK != 0)
+        else
+        {
+            if (
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+                (handle->button[offset].long_triggered != 0) ||
+#endif
+#if (MULTI_BUTTON_FEATURE_SHORT_PRESS != 0)
+                (handle->button[offset].short_triggered != 0) ||
+#endif
+                ((uint32_t)(diff) >= handle->repeat_time))                                                      /* press end or click end */
+            {
+                a_multi_button_single_finish(handle, row, col, handle->button[offset].times, &t);               /* finish the gesture */
+            }
+        }
+#endif
+    }
+    
+    return 0;                                                                                                   /* success return 0 */
+}
+
+#if (MULTI_BUTTON_FEATURE_TYPEMATIC != 0)
+
+/**
+ * @brief     single typematic
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] row set row
+ * @param[in] col set col
+ * @param[in] *t pointer to a now time structure
+ * @note      repeats are scheduled on absolute deadlines, at most one repeat is reported in each call,
+ *            the deadlines missed by a stalled process are skipped instead of reported in a burst
+ */
+static void a_multi_button_single_typematic(multi_button_handle_t *handle, uint8_t row, uint8_t col, const multi_button_time_t *t)
+{
+    uint16_t offset;
+    uint32_t step;
+    int64_t late;
+    
+    offset = handle->col * row + col;                                                                 /* get offset */
+    if (handle->button[offset].typematic_armed == 0)                                                  /* check armed */
+    {
+        return;                                                                                       /* return */
+    }
+    late = a_multi_button_diff_us(t, &handle->button[offset].typematic_time);                         /* now - deadline */
+    if (late < 0)                                                                                     /* deadline not reached */
+    {
+        return;                                                                                       /* return */
+    }
+    
+    if (late >= handle->button[offset].typematic_interval)                                            /* deadlines missed */
+    {
+        a_multi_button_time_shift(&handle->button[offset].typematic_time,
+                                  late - late % handle->button[offset].typematic_interval);           /* skip to the last missed deadline */
+    }
+    if (handle->button[offset].typematic_times < 0xFFFF)                                              /* check the max times */
+    {
+        handle->button[offset].typematic_times++;                                                     /* times++ */
+    }
+    a_multi_button_emit(handle, row, col, MULTI_BUTTON_STATUS_TYPEMATIC,
+                        handle->button[offset].typematic_times,
+                        &handle->button[offset].typematic_time);                                      /* typematic */
+    
+    a_multi_button_time_add(&handle->button[offset].typematic_time,
+                            handle->button[offset].typematic_interval);                               /* next deadline */
+    step = (uint32_t)(((uint64_t)handle->button[offset].typematic_interval *
+                      handle->typematic_acceleration) / 100);                                         /* get the step */
+    if (handle->button[offset].typematic_interval - step > handle->typematic_min_interval)            /* check the min interval */
+    {
+        handle->button[offset].typematic_interval -= step;                                            /* accelerate */
+    }
+    else
+    {
+        handle->button[offset].typematic_interval = handle->typematic_min_interval;                   /* max rate */
+    }
+}
+
+#endif
+
+/**
+ * @brief     multi button single
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] row set row
+ * @param[in] col set col
+ * @param[in] level gpio level
+ * @param[in] *edge pointer to the captured edge time, NULL if no edge time
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 trigger error
+ *            - 5 trigger too fast
+ * @note      press is 1
+ *            release is 0
+ */
+static uint8_t a_multi_button_single(multi_button_handle_t *handle, uint8_t row, uint8_t col, uint8_t level,
+                                     const multi_button_time_t *edge)
+{
+    uint8_t res;
+    uint8_t press_release;
+    uint16_t offset;
+    uint32_t bit;
+    int64_t diff;
+    multi_button_time_t t;
+    
+    offset = handle->col * row + col;                                                            /* get offset */
+    bit = (uint32_t)1 << col;                                                                    /* get the key bit */
+    if ((((handle->state[row] & bit) != 0) ? 0 : 1) != level)                                    /* if level changed */
+    {
+        handle->pending[row] |= bit;                                                             /* set pending */
+        handle->button[offset].cnt++;                                                            /* cnt++ */
+        if ((handle->button[offset].cnt == 1) && (edge != NULL))                                 /* if the debounce starts */
+        {
+            handle->button[offset].edge_time.s = edge->s;                                        /* save edge s */
+            handle->button[offset].edge_time.us = edge->us;                                      /* save edge us */
+        }
+        if (handle->button[offset].cnt > handle->repeat_cnt)                                     /* check repeat cnt */
+        {
+            handle->button[offset].cnt = 0;                                                      /* init cnt 0 */
+            handle->pending[row] &= ~bit;                                                        /* clear pending */
+            if (level != 0)                                                                      /* if now is high level */
+            {
+                press_release = 0;                                                               /* release */
+#if (MULTI_BUTTON_FEATURE_TYPEMATIC != 0)
+                handle->button[offset].typematic_armed = 0;                                      /* stop typematic */
+#endif
+                handle->state[row] &= ~bit;                                                      /* clear down state */
+            }
+            else
+            {
+                press_release = 1;                                                               /* press */
+                handle->state[row] |= bit;                                                       /* set down state */
+                handle->active[row] |= bit;                                                      /* set active */
+            }
+        }
+        else
+        {
+            return 0;                                                                            /* not reach cnt */
+        }
+    }
+    else
+    {
+        handle->button[offset].cnt = 0;                                                          /* init cnt 0 */
+        handle->pending[row] &= ~bit;                                                            /* clear pending */
+        
+        return 0;                                                                                /* no change */
+    }
+    
+    if (edge != NULL)                                                                            /* if edge time */
+    {
+        t.s = handle->button[offset].edge_time.s;                                                /* use the edge s */
+        t.us = handle->button[offset].edge_time.us;                                              /* use the edge us */
+    }
+    else
+    {
+        res = a_multi_button_timestamp_read(handle, &t);                                         /* timestamp read */
+        if (res != 0)                                                                            /* check result */
+        {
+            handle->debug_print("multi_button: timestamp read failed.\n");                       /* timestamp read failed */
+            
+            return 1;                                                                            /* return error */
+        }
+    }
+    if (press_release != 0)                                                                      /* if press */
+    {
+        handle->button[offset].press_time.s = t.s;                                               /* save press s */
+        handle->button[offset].press_time.us = t.us;                                             /* save press us */
+    }
+    else
+    {
+        handle->button[offset].hold_us = (uint32_t)a_multi_button_diff_us(&t, 
+                                         &handle->button[offset].press_time);                    /* save press duration */
+    }
+    diff = a_multi_button_diff_us(&t, &handle->button[offset].last_time);                        /* now - last time */
+    if ((press_release != 0) && (handle->button[offset].pressed == 0) &&
+        (handle->button[offset].times != 0) && ((uint32_t)(diff) >= handle->repeat_time))       /* the last gesture is over */
+    {
+        a_multi_button_single_finish(handle, row, col, handle->button[offset].times, &t);        /* finish the last gesture */
+    }
+    if (press_release != 0)                                                                      /* if press */
+    {
+        if (handle->button[offset].pressed == 0)                                                 /* press */
+        {
+            if ((uint32_t)(diff) < handle->interval)                                             /* check diff */
+            {
+                handle->debug_print("multi_button: press too fast.\n");                          /* trigger too fast */
+                a_multi_button_reset(handle, row, col, &t);                                      /* reset all */
+                
+                return 5;                                                                        /* success return 0 */
+            }
+        }
+    }
+    else                                                                                         /* if release */
+    {
+        if (handle->button[offset].pressed != 0)                                                 /* release */
+        {
+            if ((uint32_t)(diff) < handle->interval)                                             /* check diff */
+            {
+                handle->debug_print("multi_button: release too fast.\n");                        /* release too fast */
+                a_multi_button_reset(handle, row, col, &t);                                      /* reset all */
+                
+                return 5;                                                                        /* success return 0 */
+            }
+        }
+    }
+    
+    if (press_release != 0)                                                                      /* check press release */
+    {
+        a_multi_button_emit(handle, row, col, MULTI_BUTTON_STATUS_PRESS, 0, &t);                 /* press */
+#if (MULTI_BUTTON_FEATURE_TYPEMATIC != 0)
+        if ((handle->typematic != 0) &&
+            ((handle->button[offset].gesture & MULTI_BUTTON_STATUS_TYPEMATIC) != 0))             /* if typematic enabled */
+        {
+            handle->button[offset].typematic_time.s = t.s;                                       /* save s */
+            handle->button[offset].typematic_time.us = t.us;                                     /* save us */
+            a_multi_button_time_add(&handle->button[offset].typematic_time,
+                                    handle->typematic_delay);                                    /* first deadline */
+            handle->button[offset].typematic_interval = handle->typematic_interval;              /* set the start interval */
+            handle->button[offset].typematic_times = 0;                                          /* init 0 */
+            handle->button[offset].typematic_armed = 1;                                          /* arm typematic */
+        }
+#endif
+    }
+    else
+    {
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+        if (handle->button[offset].long_triggered != 0)                                          /* if long triggered */
+        {
+            a_multi_button_hold_flush(handle, row, col, &t);                                     /* report the pending holds */
+        }
+#endif
+        a_multi_button_emit(handle, row, col, MULTI_BUTTON_STATUS_RELEASE, 0, &t);               /* release */
+    }
+    
+    if (press_release != 0)                                                                      /* if press */
+    {
+        if (handle->button[offset].pressed == 0)                                                 /* press */
+        {
+            if (handle->button[offset].times < 0xFFFF)                                           /* check the max times */
+            {
+                handle->button[offset].times++;                                                  /* times++ */
+            }
+            handle->button[offset].pressed = 1;                                                  /* set pressed */
+        }
+        else
+        {
+            handle->debug_print("multi_button: double press.\n");                                /* double press */
+            a_multi_button_reset(handle, row, col, &t);                                          /* reset all */
+            
+            return 4;                                                                            /* return error */
+        }
+    }
+    else                                                                                         /* if release */
+    {
+        if (handle->button[offset].pressed != 0)                                                 /* release */
+        {
+            handle->button[offset].pressed = 0;                                                  /* clear pressed */
+        }
+        else
+        {
+            handle->debug_print("multi_button: double release.\n");                              /* double release */
+            a_multi_button_reset(handle, row, col, &t);                                          /* reset all */
+            
+            return 4;                                                                            /* return error */
+        }
+    }
+    handle->button[offset].last_time.s = t.s;                                                    /* save last time */
+    handle->button[offset].last_time.us = t.us;                                                  /* save last time */
+    if (press_release == 0)                                                                      /* if release */
+    {
+#if (MULTI_BUTTON_FEATURE_CLICK != 0)
+        uint16_t limit;
+        
+        limit = a_multi_button_click_limit(handle, offset);                                      /* get the click limit */
+        if ((limit != 0) && (handle->button[offset].times >= limit))                             /* reach the max click */
+        {
+            a_multi_button_single_finish(handle, row, col, handle->button[offset].times, &t);    /* finish at once */
+        }
+        else if ((handle->speculative != 0) && (handle->button[offset].times == 1)
+#if (MULTI_BUTTON_FEATURE_SHORT_PRESS != 0)
+                 && (handle->button[offset].short_triggered == 0)
+#endif
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+                 && (handle->button[offset].long_triggered == 0)
+#endif
+                )                                                                                /* if the first click */
+        {
+            handle->speculative_id++;                                                            /* id++ */
+            if (handle->speculative_id == 0)                                                     /* 0 is reserved */
+            {
+                handle->speculative_id = 1;                                                      /* skip 0 */
+            }
+            handle->button[offset].speculative_id = handle->speculative_id;                      /* set gesture id */
+            a_multi_button_emit(handle, row, col, MULTI_BUTTON_STATUS_CLICK_TENTATIVE, 1, &t);   /* tentative click */
+        }
+#else
+        a_multi_button_single_finish(handle, row, col, handle->button[offset].times, &t);        /* no click, finish at once */
+#endif
+    }
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     multi button select a row
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] row set row
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the caller waits the settle time before reading the row
+ */
+static uint8_t a_multi_button_select_row(multi_button_handle_t *handle, uint8_t row)
+{
+    uint8_t i;
+    uint8_t res;
+    
+    if ((handle->matrix_select_row != NULL) || (handle->matrix_select_row_ex != NULL))  /* if select linked */
+    {
+        res = a_multi_button_matrix_select_row(handle, row);                          /* select the row at once */
+        if (res != 0)                                                                 /* check result */
+        {
+            handle->debug_print("multi_button: matrix select row failed.\n");         /* matrix select row failed */
+            
+            return 1;                                                                 /* return error */
+        }
+        
+        return 0;                                                                     /* success return 0 */
+    }
+    for (i = 0; i < handle->row; i++)                                                 /* loop all row */
+    {
+        if (i != row)                                                                 /* not set row */
+        {
+            res = a_multi_button_matrix_write_row(handle, i, 1);                      /* set row high */
+            if (res != 0)                                                             /* check result */
+            {
+                handle->debug_print("multi_button: matrix write row failed.\n");      /* matrix write row failed */
+                
+                return 1;                                                             /* return error */
+            }
+        }
+        else
+        {
+            res = a_multi_button_matrix_write_row(handle, i, 0);                      /* set row low */
+            if (res != 0)                                                             /* check result */
+            {
+                handle->debug_print("multi_button: matrix write row failed.\n");      /* matrix write row failed */
+                
+                return 1;                                                             /* return error */
+            }
+        }
+    }
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief     multi button set matrix level
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] row set row
+ * @note      none
+ */
+static uint8_t a_multi_button_set_matrix_level(multi_button_handle_t *handle, uint8_t row)
+{
+    uint8_t res;
+    
+    res = a_multi_button_select_row(handle, row);                                     /* select the row */
+    if (res != 0)                                                                     /* check result */
+    {
+        return 1;                                                                     /* return error */
+    }
+    a_multi_button_delay_ms(handle, 1);                                               /* delay 1ms */
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief      begin a scan of all buttons
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *t pointer to a time buffer
+ * @param[out] *diff pointer to a period diff buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       none
+ */
+static uint8_t a_multi_button_scan_begin(multi_button_handle_t *handle, multi_button_time_t *t, int64_t *diff)
+{
+    uint8_t res;
+    
+    res = a_multi_button_timestamp_read(handle, t);                                                     /* timestamp read */
+    if (res != 0)                                                                                       /* check result */
+    {
+        handle->debug_print("multi_button: timestamp read failed.\n");                                  /* timestamp read failed */
+        
+        return 1;                                                                                       /* return error */
+    }
+    *diff = (int64_t)(t->s - handle->check_time.s) * 1000000 + 
+            (int64_t)(t->us - handle->check_time.us) ;                                                  /* now - last time */
+    if ((uint32_t)(*diff) > handle->period)                                                             /* check period */
+    {
+        handle->check_time.s = t->s;                                                                    /* save s */
+        handle->check_time.us = t->us;                                                                  /* save us */
+    }
+    
+    return 0;                                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     scan a selected row
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] row scanned row
+ * @param[in] *t pointer to the scan time
+ * @param[in] diff period diff of the scan
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the row must be selected and settled
+ */
+static uint8_t a_multi_button_scan_row(multi_button_handle_t *handle, uint8_t row, const multi_button_time_t *t, int64_t diff)
+{
+    uint8_t j;
+    uint8_t res; 
+    uint16_t offset;
+    uint32_t col_array;
+    uint32_t mask;
+    uint32_t work;
+    uint32_t visit;
+    uint32_t bit;
+    multi_button_time_t *edge;
+    multi_button_time_t edge_buf[32];
+    
+    if ((handle->matrix_read_row_timestamp != NULL) || (handle->matrix_read_row_timestamp_ex != NULL))  /* if edge time linked */
+    {
+        for (j = 0; j < handle->col; j++)                                                               /* loop all col */
+        {
+            edge_buf[j].s = t->s;                                                                       /* default scan s */
+            edge_buf[j].us = t->us;                                                                     /* default scan us */
+        }
+        edge = edge_buf;                                                                                /* use the edge buffer */
+        res = a_multi_button_matrix_read_row_timestamp(handle, &col_array, edge);                       /* read row with edge time */
+    }
+    else
+    {
+        edge = NULL;                                                                                    /* no edge time */
+        res = a_multi_button_matrix_read_row(handle, &col_array);                                       /* read row */
+    }
+    if (res != 0)                                                                                       /* check result */
+    {
+        handle->debug_print("multi_button: matrix read row failed.\n");                                 /* matrix read failed */
+        
+        return 1;                                                                                       /* return error */
+    }
+    mask = (handle->col >= 32) ? 0xFFFFFFFFU : (((uint32_t)1 << handle->col) - 1);                     /* get the col mask */
+    work = (((~col_array) & mask) ^ handle->state[row]) | handle->pending[row];                        /* changed or pending keys */
+    visit = work | handle->active[row];                                                                 /* keys to visit */
+    for (j = 0; (j < handle->col) && ((visit >> j) != 0); j++)                                          /* loop the visited keys */
+    {
+        bit = (uint32_t)1 << j;                                                                         /* get the key bit */
+        if ((visit & bit) == 0)                                                                         /* quiet key */
+        {
+            continue;                                                                                   /* next */
+        }
+        if ((work & bit) != 0)                                                                          /* check work */
+        {
+            res = a_multi_button_single(handle, row, j, (col_array >> j) & 0x1,
+                                        (edge != NULL) ? &edge[j] : NULL);                              /* single process */
+            if (res != 0)                                                                               /* check result */
+            {
+                return 1;                                                                               /* return error */
+            }
+        }
+        if ((handle->active[row] & bit) == 0)                                                           /* not active */
+        {
+            continue;                                                                                   /* next */
+        }
+        if ((uint32_t)(diff) >= handle->period)                                                         /* check period */
+        {
+            res = a_multi_button_single_period(handle, row, j);                                         /* read period */
+            if (res != 0)                                                                               /* check result */
+            {
+                return 1;                                                                               /* return error */
+            }
+        }
+        offset = handle->col * row + j;                                                                 /* get offset */
+#if (MULTI_BUTTON_FEATURE_TYPEMATIC != 0)
+        a_multi_button_single_typematic(handle, row, j, t);                                             /* typematic */
+        if ((handle->button[offset].times == 0) && (handle->button[offset].typematic_armed == 0))       /* gesture is over */
+#else
+        (void)t;                                                                                        /* no typematic */
+        if (handle->button[offset].times == 0)                                                          /* gesture is over */
+#endif
+        {
+            handle->active[row] &= ~bit;                                                                /* clear active */
+        }
+    }
+    
+    return 0;                                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     scan all buttons
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_multi_button_scan(multi_button_handle_t *handle)
+{
+    uint8_t i;
+    uint8_t res; 
+    int64_t diff;
+    multi_button_time_t t;
+    
+    res = a_multi_button_scan_begin(handle, &t, &diff);                                                 /* begin the scan */
+    if (res != 0)                                                                                       /* check result */
+    {
+        return 1;                                                                                       /* return error */
+    }
+    for (i = 0; i < handle->row; i++)                                                                   /* loop all row */
+    {
+        res = a_multi_button_set_matrix_level(handle, i);                                               /* set matrix level */
+        if (res != 0)                                                                                   /* check result */
+        {
+            return 1;                                                                                   /* return error */
+        }
+        res = a_multi_button_scan_row(handle, i, &t, diff);                                             /* scan the row */
+        if (res != 0)                                                                                   /* check result */
+        {
+            return 1;                                                                                   /* return error */
+        }
+    }
+    
+    return 0;                                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     process
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the batched events are delivered at the end of each process,
+ *            a full batch is delivered at once
+ */
+uint8_t multi_button_process(multi_button_handle_t *handle)
+{
+    uint8_t res;
+    
+    res = a_multi_button_scan(handle);          /* scan all buttons */
+#if (MULTI_BUTTON_BATCH_LENGTH > 0)
+    a_multi_button_batch_flush(handle);         /* deliver the batched events */
+#endif
+    
+    return res;                                 /* return the result */
+}
+
+/**
+ * @brief     initialize the chip with a button storage
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] row max row of buttons
+ * @param[in] col max col of buttons
+ * @param[in] *button pointer to a button storage
+ * @param[in] number button number of the storage
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 row or col is invalid
+ *            - 5 matrix init failed
+ * @note      none
+ */
+static uint8_t a_multi_button_init(multi_button_handle_t *handle, uint8_t row, uint8_t col,
+                                   multi_button_single_t *button, uint32_t number)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t j;
+    uint16_t offset;
+    multi_button_time_t t;
+    
+    if (handle == NULL)                                                                     /* check handle */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (handle->debug_print == NULL)                                                        /* check debug_print */
+    {
+        return 3;                                                                           /* return error */
+    }
+    
+    if (row == 0)                                                                           /* check row */
+    {
+        handle->debug_print("multi_button: row can't be 0.\n");                             /* row can't be 0 */
+        
+        return 4;                                                                           /* return error */
+    }
+    if (col == 0)                                                                           /* check col */
+    {
+        handle->debug_print("multi_button: col can't be 0.\n");                             /* col can't be 0 */
+        
+        return 4;                                                                           /* return error */
+    }
+    if (row > MULTI_BUTTON_ROW_NUMBER)                                                      /* check row */
+    {
+        handle->debug_print("multi_button: row > %d.\n", MULTI_BUTTON_ROW_NUMBER);          /* row > max row */
+        
+        return 4;                                                                           /* return error */
+    }
+    if (col > 32)                                                                           /* check col */
+    {
+        handle->debug_print("multi_button: col > 32.\n");                                   /* col > 32 */
+        
+        return 4;                                                                           /* return error */
+    }
+    if ((uint32_t)row * col > number)                                                       /* check row and col size */
+    {
+        handle->debug_print("multi_button: row * col > %d.\n", (int)number);               /* row * col > number */
+        
+        return 4;                                                                           /* return error */
+    }
+    
+    if ((handle->matrix_init == NULL) && (handle->matrix_init_ex == NULL))                  /* check matrix_init */
+    {
+        handle->debug_print("multi_button: matrix_init is null.\n");                        /* matrix_init is null */
+        
+        return 3;                                                                           /* return error */
+    }
+    if ((handle->matrix_deinit == NULL) && (handle->matrix_deinit_ex == NULL))              /* check matrix_deinit */
+    {
+        handle->debug_print("multi_button: matrix_deinit is null.\n");                      /* matrix_deinit is null */
+        
+        return 3;                                                                           /* return error */
+    }
+    if ((handle->matrix_write_row == NULL) && (handle->matrix_write_row_ex == NULL))        /* check matrix_write_row */
+    {
+        handle->debug_print("multi_button: matrix_write_row is null.\n");                   /* matrix_write_row is null */
+        
+        return 3;                                                                           /* return error */
+    }
+    if ((handle->matrix_read_row == NULL) && (handle->matrix_read_row_ex == NULL))          /* check matrix_read_row */
+    {
+        handle->debug_print("multi_button: matrix_read_row is null.\n");                    /* matrix_read_row is null */
+        
+        return 3;                                                                           /* return error */
+    }
+    if ((handle->timestamp_read == NULL) && (handle->timestamp_read_ex == NULL))            /* check timestamp_read */
+    {
+        handle->debug_print("multi_button: timestamp_read is null.\n");                     /* timestamp_read is null */
+        
+        return 3;                                                                           /* return error */
+    }
+    if ((handle->delay_ms == NULL) && (handle->delay_ms_ex == NULL))                        /* check delay_ms */
+    {
+        handle->debug_print("multi_button: delay_ms is null.\n");                           /* delay_ms is null */
+        
+        return 3;                                                                           /* return error */
+    }
+#if (MULTI_BUTTON_EVENT_RING_SIZE == 0) && (MULTI_BUTTON_SUBSCRIBER_NUMBER == 0)
+    if ((handle->receive_callback == NULL) && (handle->receive_callback_ex == NULL) &&
+#if (MULTI_BUTTON_BATCH_LENGTH > 0)
+        (handle->receive_batch_callback == NULL) &&
+#endif
+        (handle->receive_event_callback == NULL))                                           /* check receive_callback */
+    {
+        handle->debug_print("multi_button: receive_callback is null.\n");                   /* receive_callback is null */
+        
+        return 3;                                                                           /* return error */
+    }
+#endif
+    
+    handle->row = row;                                                                      /* set row */
+    handle->col = col;                                                                      /* set col */
+    handle->button = button;                                                                /* set button storage */
+    handle->last_timestamp.s = 0;                                                           /* init last timestamp */
+    handle->last_timestamp.us = 0;                                                          /* init last timestamp */
+    handle->clock_step_cnt = 0;                                                             /* init 0 */
+    res = a_multi_button_timestamp_read(handle, &t);                                        /* timestamp read */
+    if (res != 0)                                                                           /* check result */
+    {
+        handle->debug_print("multi_button: timestamp read failed.\n");                      /* timestamp read failed */
+        
+        return 1;                                                                           /* return error */
+    }
+    handle->check_time.s = t.s;                                                             /* save the current s */
+    handle->check_time.us = t.us;                                                           /* save the current us */
+    a_multi_button_set_param(handle);                                                       /* set params */
+    memset(handle->state, 0, sizeof(handle->state));                                        /* clear down state */
+    memset(handle->pending, 0, sizeof(handle->pending));                                    /* clear pending */
+    memset(handle->active, 0, sizeof(handle->active));                                      /* clear active */
+    handle->seq = 0;                                                                        /* init sequence number */
+#if (MULTI_BUTTON_BATCH_LENGTH > 0)
+    handle->batch_len = 0;                                                                  /* init batch length */
+#endif
+#if (MULTI_BUTTON_SUBSCRIBER_NUMBER > 0)
+    memset(handle->subscriber, 0, sizeof(handle->subscriber));                              /* clear subscribers */
+    memset(handle->subscriber_status, 0, sizeof(handle->subscriber_status));                /* clear subscriber status */
+#endif
+#if (MULTI_BUTTON_EVENT_RING_SIZE > 0)
+    atomic_store(&handle->event_head, 0);                                                   /* init head */
+    atomic_store(&handle->event_tail, 0);                                                   /* init tail */
+    atomic_store(&handle->event_overflow, 0);                                               /* init overflow */
+    handle->event_ring_enable = 0;                                                          /* disable event ring */
+    handle->event_policy = MULTI_BUTTON_OVERFLOW_DROP_NEWEST;                               /* drop the newest */
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+    handle->hold_coalesce = 0;                                                              /* disable hold coalesce */
+#endif
+#endif
+    for (i = 0; i < row; i++)                                                               /* loop row */
+    {
+        for (j = 0; j < col; j++)                                                           /* loop col */
+        {
+            offset = handle->col * i + j;                                                   /* get offset */
+            memset(&handle->button[offset], 0, sizeof(multi_button_single_t));              /* clear button */
+            handle->button[offset].cnt = 0;                                                 /* init cnt 0 */
+            handle->button[offset].gesture = MULTI_BUTTON_GESTURE;                          /* enable all gestures */
+            handle->button[offset].last_time.s = t.s;                                       /* save last time */
+            handle->button[offset].last_time.us = t.us;                                     /* save last time */
+            handle->button[offset].press_time.s = t.s;                                      /* save press time */
+            handle->button[offset].press_time.us = t.us;                                    /* save press time */
+#if (MULTI_BUTTON_EVENT_RING_SIZE > 0) && (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+            atomic_init(&handle->button[offset].hold_merge, 0);                             /* no hold queued */
+#endif
+        }
+    }
+    res = a_multi_button_matrix_init(handle);                                               /* matrix init */
+    if (res != 0)                                                                           /* check the result */
+    {
+        handle->debug_print("multi_button: matrix init failed.\n");                         /* matrix init failed */
+        
+        return 5;                                                                           /* return error */
+    }
+    
+    handle->inited = 1;                                                                     /* flag inited */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     initialize the chip
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] row max row of buttons
+ * @param[in] col max col of buttons
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 row or col is invalid
+ *            - 5 matrix init failed
+ * @note      it uses the inline storage and needs MULTI_BUTTON_NUMBER > 0,
+ *            row is at most MULTI_BUTTON_ROW_NUMBER
+ */
+uint8_t multi_button_init(multi_button_handle_t *handle, uint8_t row, uint8_t col)
+{
+#if (MULTI_BUTTON_NUMBER > 0)
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    
+    return a_multi_button_init(handle, row, col, handle->button_buffer, MULTI_BUTTON_NUMBER);   /* init with the inline storage */
+#else
+    (void)row;                                                                                  /* not used */
+    (void)col;                                                                                  /* not used */
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (handle->debug_print == NULL)                                                            /* check debug_print */
+    {
+        return 3;                                                                               /* return error */
+    }
+    handle->debug_print("multi_button: no inline storage, use multi_button_init_with_buffer.\n");
+    
+    return 4;                                                                                   /* return error */
+#endif
+}
+
+/**
+ * @brief     initialize the chip with a caller-provided button storage
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] row max row of buttons
+ * @param[in] col max col of buttons
+ * @param[in] *buf pointer to a button storage buffer
+ * @param[in] size buffer size in bytes
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 row or col is invalid
+ *            - 5 matrix init failed
+ *            - 6 buffer is invalid
+ * @note      size must be at least MULTI_BUTTON_STORAGE_SIZE(row, col),
+ *            the buffer must stay valid until multi_button_deinit,
+ *            row is at most MULTI_BUTTON_ROW_NUMBER
+ */
+uint8_t multi_button_init_with_buffer(multi_button_handle_t *handle, uint8_t row, uint8_t col, void *buf, size_t size)
+{
+    struct multi_button_align_s
+    {
+        char c;
+        multi_button_single_t s;
+    };
+    
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (handle->debug_print == NULL)                                                            /* check debug_print */
+    {
+        return 3;                                                                               /* return error */
+    }
+    if (buf == NULL)                                                                            /* check buffer */
+    {
+        handle->debug_print("multi_button: buf is null.\n");                                    /* buf is null */
+        
+        return 6;                                                                               /* return error */
+    }
+    if (((uintptr_t)buf % offsetof(struct multi_button_align_s, s)) != 0)                      /* check alignment */
+    {
+        handle->debug_print("multi_button: buf is not aligned.\n");                             /* buf is not aligned */
+        
+        return 6;                                                                               /* return error */
+    }
+    if (size < MULTI_BUTTON_STORAGE_SIZE(row, col))                                             /* check size */
+    {
+        handle->debug_print("multi_button: buf is too small.\n");                               /* buf is too small */
+        
+        return 6;                                                                               /* return error */
+    }
+    
+    return a_multi_button_init(handle, row, col, (multi_button_single_t *)buf,
+                               (uint32_t)(size / sizeof(multi_button_single_t)));              /* init with the buffer */
+}
+
+/**
+ * @brief     close the chip
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t multi_button_deinit(multi_button_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                      /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                 /* check handle initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    
+    res = a_multi_button_matrix_deinit(handle);                              /* matrix deinit */
+    if (res != 0)                                                            /* check the result */
+    {
+        handle->debug_print("multi_button: matrix deinit failed.\n");        /* matrix deinit failed */
+        
+        return 1;                                                            /* return error */
+    }
+    handle->inited = 0;                                                      /* flag close */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief     set timeout
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] us set time
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t multi_button_set_timeout(multi_button_handle_t *handle, uint32_t us)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    handle->timeout = us;           /* set timeout */
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief      get timeout
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_timeout(multi_button_handle_t *handle, uint32_t *us)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    *us = handle->timeout;          /* get timeout */
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief     set interval
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] us set time
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t multi_button_set_interval(multi_button_handle_t *handle, uint32_t us)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    handle->interval = us;          /* set interval */
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief      get interval
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_interval(multi_button_handle_t *handle, uint32_t *us)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    *us = handle->interval;         /* get interval */
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief     set short time
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] us set time
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t multi_button_set_short_time(multi_button_handle_t *handle, uint32_t us)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    handle->short_time = us;        /* set short time */
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief      get short time
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_short_time(multi_button_handle_t *handle, uint32_t *us)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    *us = handle->short_time;       /* get short time */
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief     set long time
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] us set time
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t multi_button_set_long_time(multi_button_handle_t *handle, uint32_t us)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    handle->long_time = us;         /* set long time */
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief      get long time
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_long_time(multi_button_handle_t *handle, uint32_t *us)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    *us = handle->long_time;        /* get long time */
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief     set repeat time
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] us set time
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t multi_button_set_repeat_time(multi_button_handle_t *handle, uint32_t us)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    handle->repeat_time = us;       /* set repeat time */
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief      get repeat time
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_repeat_time(multi_button_handle_t *handle, uint32_t *us)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    *us = handle->repeat_time;      /* get repeat time */
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief     set repeat cnt
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] cnt set repeat counter
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t multi_button_set_repeat_cnt(multi_button_handle_t *handle, uint32_t cnt)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    handle->repeat_cnt = cnt;       /* set repeat cnt */
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief      get repeat cnt
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *cnt pointer to a counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_repeat_cnt(multi_button_handle_t *handle, uint32_t *cnt)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    *cnt = handle->repeat_cnt;      /* get repeat cnt */
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief     set period
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] period set period
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t multi_button_set_period(multi_button_handle_t *handle, uint32_t period)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    handle->period = period;        /* set period */
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief      get period
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *period pointer to a period buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_period(multi_button_handle_t *handle, uint32_t *period)
+{
+    if (handle == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (handle->inited != 1)        /* check handle initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    *period = handle->period;       /* get period */
+    
+    return 0;                       /* success return 0 */
+}
+
+#if (MULTI_BUTTON_FEATURE_TYPEMATIC != 0)
+
+/**
+ * @brief     enable or disable the typematic repeat
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      disabling also stops the repeat of the keys already held
+ */
+uint8_t multi_button_set_typematic(multi_button_handle_t *handle, multi_button_bool_t enable)
+{
+    uint16_t i;
+    
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+    handle->typematic = (uint8_t)enable;                                 /* set typematic */
+    if (enable == MULTI_BUTTON_BOOL_FALSE)                               /* if disabled */
+    {
+        for (i = 0; i < (uint16_t)(handle->row * handle->col); i++)      /* loop all buttons */
+        {
+            handle->button[i].typematic_armed = 0;                       /* stop the held keys */
+        }
+    }
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the typematic repeat status
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_typematic(multi_button_handle_t *handle, multi_button_bool_t *enable)
+{
+    if (handle == NULL)                                       /* check handle */
+    {
+        return 2;                                             /* return error */
+    }
+    if (handle->inited != 1)                                  /* check handle initialization */
+    {
+        return 3;                                             /* return error */
+    }
+    
+    *enable = (multi_button_bool_t)(handle->typematic);       /* get typematic */
+    
+    return 0;                                                 /* success return 0 */
+}
+
+/**
+ * @brief     set typematic delay
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] us set time
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the time from the press to the first typematic repeat
+ */
+uint8_t multi_button_set_typematic_delay(multi_button_handle_t *handle, uint32_t us)
+{
+    if (handle == NULL)                 /* check handle */
+    {
+        return 2;                       /* return error */
+    }
+    if (handle->inited != 1)            /* check handle initialization */
+    {
+        return 3;                       /* return error */
+    }
+    
+    handle->typematic_delay = us;       /* set typematic delay */
+    
+    return 0;                           /* success return 0 */
+}
+
+/**
+ * @brief      get typematic delay
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_typematic_delay(multi_button_handle_t *handle, uint32_t *us)
+{
+    if (handle == NULL)                 /* check handle */
+    {
+        return 2;                       /* return error */
+    }
+    if (handle->inited != 1)            /* check handle initialization */
+    {
+        return 3;                       /* return error */
+    }
+    
+    *us = handle->typematic_delay;      /* get typematic delay */
+    
+    return 0;                           /* success return 0 */
+}
+
+/**
+ * @brief     set typematic interval
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] us set time
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 us can't be 0
+ * @note      the interval between the first and the second typematic repeat
+ */
+uint8_t multi_button_set_typematic_interval(multi_button_handle_t *handle, uint32_t us)
+{
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    if (us == 0)                                                            /* check us */
+    {
+        handle->debug_print("multi_button: us can't be 0.\n");              /* us can't be 0 */
+        
+        return 4;                                                           /* return error */
     }
     
-    return 0;                                                                                                   /* success return 0 */
+    handle->typematic_interval = us;                                        /* set typematic interval */
+    
+    return 0;                                                               /* success return 0 */
 }
 
 /**
- * @brief     multi button single
+ * @brief      get typematic interval
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_typematic_interval(multi_button_handle_t *handle, uint32_t *us)
+{
+    if (handle == NULL)                    /* check handle */
+    {
+        return 2;                          /* return error */
+    }
+    if (handle->inited != 1)               /* check handle initialization */
+    {
+        return 3;                          /* return error */
+    }
+    
+    *us = handle->typematic_interval;      /* get typematic interval */
+    
+    return 0;                              /* success return 0 */
+}
+
+/**
+ * @brief     set typematic min interval
  * @param[in] *handle pointer to a multi_button handle structure
- * @param[in] row set row
- * @param[in] col set col
- * @param[in] level gpio level
+ * @param[in] us set time
  * @return    status code
  *            - 0 success
- *            - 1 run failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 trigger error
- *            - 5 trigger too fast
- * @note      press is 1
- *            release is 0
+ *            - 4 us can't be 0
+ * @note      the interval at the max typematic rate
  */
-static uint8_t a_multi_button_single(multi_button_handle_t *handle, uint8_t row, uint8_t col, uint8_t level)
+uint8_t multi_button_set_typematic_min_interval(multi_button_handle_t *handle, uint32_t us)
 {
-    uint8_t res;
-    uint8_t press_release;
-    uint16_t offset;
-    int64_t diff;
-    multi_button_time_t t;
-    
-    offset = handle->col * row + col;                                                            /* get offset */
-    if (handle->button[offset].level != level)                                                   /* if level changed */
+    if (handle == NULL)                                                     /* check handle */
     {
-        handle->button[offset].cnt++;                                                            /* cnt++ */
-        if (handle->button[offset].cnt > handle->repeat_cnt)                                     /* check repeat cnt */
-        {
-            handle->button[offset].level = level;                                                /* set level */
-            handle->button[offset].cnt = 0;                                                      /* init cnt 0 */
-            if (handle->button[offset].level != 0)                                               /* if now is high level */
-            {
-                press_release = 0;                                                               /* release */
-            }
-            else
-            {
-                press_release = 1;                                                               /* press */
-            }
-        }
-        else
-        {
-            return 0;                                                                            /* not reach cnt */
-        }
+        return 2;                                                           /* return error */
     }
-    else
+    if (handle->inited != 1)                                                /* check handle initialization */
     {
-        handle->button[offset].cnt = 0;                                                          /* init cnt 0 */
-        
-        return 0;                                                                                /* no change */
+        return 3;                                                           /* return error */
     }
-    
-    res = handle->timestamp_read(&t);                                                            /* timestamp read */
-    if (res != 0)                                                                                /* check result */
+    if (us == 0)                                                            /* check us */
     {
-        handle->debug_print("multi_button: timestamp read failed.\n");                           /* timestamp read failed */
+        handle->debug_print("multi_button: us can't be 0.\n");              /* us can't be 0 */
         
-        return 1;                                                                                /* return error */
+        return 4;                                                           /* return error */
     }
-    diff = (int64_t)(t.s - handle->button[offset].last_time.s) * 1000000 + 
-           (int64_t)(t.us - handle->button[offset].last_time.us) ;                               /* now - last time */
-    if (press_release != 0)                                                                      /* if press */
+    
+    handle->typematic_min_interval = us;                                    /* set typematic min interval */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief      get typematic min interval
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_typematic_min_interval(multi_button_handle_t *handle, uint32_t *us)
+{
+    if (handle == NULL)                        /* check handle */
     {
-        if ((handle->button[offset].decode_len % 2) == 0)                                        /* press */
-        {
-            if ((uint32_t)(diff) < handle->interval)                                             /* check diff */
-            {
-                handle->debug_print("multi_button: press too fast.\n");                          /* trigger too fast */
-                a_multi_button_reset(handle, row, col);                                          /* reset all */
-                
-                return 5;                                                                        /* success return 0 */
-            }
-        }
+        return 2;                              /* return error */
     }
-    else                                                                                         /* if release */
+    if (handle->inited != 1)                   /* check handle initialization */
     {
-        if ((handle->button[offset].decode_len % 2) != 0)                                        /* release */
-        {
-            if ((uint32_t)(diff) < handle->interval)                                             /* check diff */
-            {
-                handle->debug_print("multi_button: release too fast.\n");                        /* release too fast */
-                a_multi_button_reset(handle, row, col);                                          /* reset all */
-                
-                return 5;                                                                        /* success return 0 */
-            }
-        }
+        return 3;                              /* return error */
     }
     
-    if (press_release != 0)                                                                      /* check press release */
+    *us = handle->typematic_min_interval;      /* get typematic min interval */
+    
+    return 0;                                  /* success return 0 */
+}
+
+/**
+ * @brief     set typematic acceleration
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] percent interval shrink percent after each repeat
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 percent > 100
+ * @note      0 means a constant rate
+ */
+uint8_t multi_button_set_typematic_acceleration(multi_button_handle_t *handle, uint8_t percent)
+{
+    if (handle == NULL)                                                     /* check handle */
     {
-        if (handle->receive_callback != NULL)                                                    /* if not null */
-        {
-            multi_button_t multi_button;
-            
-            multi_button.status = MULTI_BUTTON_STATUS_PRESS;                                     /* press */
-            multi_button.times = 0;                                                              /* 0 times */
-            handle->receive_callback(row, col, &multi_button);                                   /* run the reception callback */
-        }
+        return 2;                                                           /* return error */
     }
-    else
+    if (handle->inited != 1)                                                /* check handle initialization */
     {
-        if (handle->receive_callback != NULL)                                                    /* if not null */
-        {
-            multi_button_t multi_button;
-            
-            multi_button.status = MULTI_BUTTON_STATUS_RELEASE;                                   /* release */
-            multi_button.times = 0;                                                              /* 0 times */
-            handle->receive_callback(row, col, &multi_button);                                   /* run the reception callback */
-        }
+        return 3;                                                           /* return error */
     }
-    
-    if (handle->button[offset].decode_len >= (MULTI_BUTTON_EACH_LENGTH - 1))                     /* check the max length */
+    if (percent > 100)                                                      /* check percent */
     {
-        a_multi_button_reset(handle, row, col);                                                  /* reset all */
+        handle->debug_print("multi_button: percent > 100.\n");              /* percent > 100 */
+        
+        return 4;                                                           /* return error */
     }
-    if (press_release != 0)                                                                      /* if press */
+    
+    handle->typematic_acceleration = percent;                               /* set typematic acceleration */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief      get typematic acceleration
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *percent pointer to a percent buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_typematic_acceleration(multi_button_handle_t *handle, uint8_t *percent)
+{
+    if (handle == NULL)                                /* check handle */
     {
-        if ((handle->button[offset].decode_len % 2) == 0)                                        /* press */
-        {
-            handle->button[offset].decode[handle->button[offset].decode_len].t.s = t.s;          /* save s */
-            handle->button[offset].decode[handle->button[offset].decode_len].t.us = t.us;        /* save us */
-            handle->button[offset].decode_len++;                                                 /* length++ */
-        }
-        else
-        {
-            handle->debug_print("multi_button: double press.\n");                                /* double press */
-            a_multi_button_reset(handle, row, col);                                              /* reset all */
-            
-            return 4;                                                                            /* return error */
-        }
+        return 2;                                      /* return error */
     }
-    else                                                                                         /* if release */
+    if (handle->inited != 1)                           /* check handle initialization */
     {
-        if ((handle->button[offset].decode_len % 2) != 0)                                        /* release */
-        {
-            handle->button[offset].decode[handle->button[offset].decode_len].t.s = t.s;          /* save s */
-            handle->button[offset].decode[handle->button[offset].decode_len].t.us = t.us;        /* save us */
-            handle->button[offset].decode_len++;                                                 /* length++ */
-        }
-        else
-        {
-            handle->debug_print("multi_button: double release.\n");                              /* double release */
-            a_multi_button_reset(handle, row, col);                                              /* reset all */
-            
-            return 4;                                                                            /* return error */
-        }
+        return 3;                                      /* return error */
     }
-    handle->button[offset].last_time.s = t.s;                                                    /* save last time */
-    handle->button[offset].last_time.us = t.us;                                                  /* save last time */
     
-    return 0;                                                                                    /* success return 0 */
+    *percent = handle->typematic_acceleration;         /* get typematic acceleration */
+    
+    return 0;                                          /* success return 0 */
 }
 
+#endif
+
 /**
- * @brief     multi button set matrix level
+ * @brief     set the enabled gestures of a button
  * @param[in] *handle pointer to a multi_button handle structure
- * @param[in] row set row
- * @note      none
+ * @param[in] row button row
+ * @param[in] col button col
+ * @param[in] mask or'ed multi_button_status_t of the enabled gestures
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 row or col is invalid
+ * @note      disabled statuses are never reported,
+ *            if double, triple and repeat click are all disabled,
+ *            the single click is reported at the release without waiting the repeat time
  */
-static uint8_t a_multi_button_set_matrix_level(multi_button_handle_t *handle, uint8_t row)
+uint8_t multi_button_set_gesture(multi_button_handle_t *handle, uint8_t row, uint8_t col, uint16_t mask)
 {
-    uint8_t i;
-    uint8_t res;
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    if ((row >= handle->row) || (col >= handle->col))                       /* check row and col */
+    {
+        handle->debug_print("multi_button: row or col is invalid.\n");      /* row or col is invalid */
+        
+        return 4;                                                           /* return error */
+    }
     
-    for (i = 0; i < handle->row; i++)                                                 /* loop all row */
+    handle->button[handle->col * row + col].gesture = mask;                 /* set gesture */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief      get the enabled gestures of a button
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[in]  row button row
+ * @param[in]  col button col
+ * @param[out] *mask pointer to a mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 row or col is invalid
+ * @note       none
+ */
+uint8_t multi_button_get_gesture(multi_button_handle_t *handle, uint8_t row, uint8_t col, uint16_t *mask)
+{
+    if (handle == NULL)                                                     /* check handle */
     {
-        if (i != row)                                                                 /* not set row */
-        {
-            res = handle->matrix_write_row(i, 1);                                     /* set row high */
-            if (res != 0)                                                             /* check result */
-            {
-                handle->debug_print("multi_button: matrix write row failed.\n");      /* matrix write row failed */
-                
-                return 1;                                                             /* return error */
-            }
-        }
-        else
-        {
-            res = handle->matrix_write_row(i, 0);                                     /* set row low */
-            if (res != 0)                                                             /* check result */
-            {
-                handle->debug_print("multi_button: matrix write row failed.\n");      /* matrix write row failed */
-                
-                return 1;                                                             /* return error */
-            }
-        }
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    if ((row >= handle->row) || (col >= handle->col))                       /* check row and col */
+    {
+        handle->debug_print("multi_button: row or col is invalid.\n");      /* row or col is invalid */
+        
+        return 4;                                                           /* return error */
     }
-    handle->delay_ms(1);                                                              /* delay 1ms */
     
-    return 0;                                                                         /* success return 0 */
+    *mask = handle->button[handle->col * row + col].gesture;                /* get gesture */
+    
+    return 0;                                                               /* success return 0 */
 }
 
+#if (MULTI_BUTTON_FEATURE_CLICK != 0)
+
 /**
- * @brief     process
+ * @brief     set the max click times of a button
  * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] row button row
+ * @param[in] col button col
+ * @param[in] times max click times
  * @return    status code
  *            - 0 success
- *            - 1 run failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 row or col is invalid
+ * @note      0 means no limit,
+ *            the click is reported at the release which reaches the max times
  */
-uint8_t multi_button_process(multi_button_handle_t *handle)
+uint8_t multi_button_set_max_click(multi_button_handle_t *handle, uint8_t row, uint8_t col, uint16_t times)
 {
-    uint8_t i;
-    uint8_t j;
-    uint8_t res; 
-    uint32_t col_array;
-    int64_t diff;
-    multi_button_time_t t;
-    
-    res = handle->timestamp_read(&t);                                                                   /* timestamp read */
-    if (res != 0)                                                                                       /* check result */
+    if (handle == NULL)                                                     /* check handle */
     {
-        handle->debug_print("multi_button: timestamp read failed.\n");                                  /* timestamp read failed */
-        
-        return 1;                                                                                       /* return error */
+        return 2;                                                           /* return error */
     }
-    diff = (int64_t)(t.s - handle->check_time.s) * 1000000 + 
-           (int64_t)(t.us - handle->check_time.us) ;                                                    /* now - last time */
-    if ((uint32_t)(diff) > handle->period)                                                              /* check period */
+    if (handle->inited != 1)                                                /* check handle initialization */
     {
-        handle->check_time.s = t.s;                                                                     /* save s */
-        handle->check_time.us = t.us;                                                                   /* save us */
+        return 3;                                                           /* return error */
     }
-    for (i = 0; i < handle->row; i++)                                                                   /* loop all row */
+    if ((row >= handle->row) || (col >= handle->col))                       /* check row and col */
     {
-        res = a_multi_button_set_matrix_level(handle, i);                                               /* set matrix level */
-        if (res != 0)                                                                                   /* check result */
-        {
-            return 1;                                                                                   /* return error */
-        }
-        res = handle->matrix_read_row(&col_array);                                                      /* read row */
-        if (res != 0)                                                                                   /* check result */
-        {
-            handle->debug_print("multi_button: matrix read row failed.\n");                             /* matrix read failed */
-            
-            return 1;                                                                                   /* return error */
-        }
-        for (j = 0; j < handle->col; j++)                                                               /* loop col all */
-        {
-            res = a_multi_button_single(handle, i, j, (col_array >> j) & 0x1);                          /* single process */
-            if (res != 0)                                                                               /* check result */
-            {
-                return 1;                                                                               /* return error */
-            }
-            if ((uint32_t)(diff) >= handle->period)                                                     /* check period */
-            {
-                res = a_multi_button_single_period(handle, i, j);                                       /* read period */
-                if (res != 0)                                                                           /* check result */
-                {
-                    return 1;                                                                           /* return error */
-                }
-            }
-        }
+        handle->debug_print("multi_button: row or col is invalid.\n");      /* row or col is invalid */
+        
+        return 4;                                                           /* return error */
+    }
+    
+    handle->button[handle->col * row + col].max_click = times;              /* set max click */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief      get the max click times of a button
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[in]  row button row
+ * @param[in]  col button col
+ * @param[out] *times pointer to a times buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 row or col is invalid
+ * @note       none
+ */
+uint8_t multi_button_get_max_click(multi_button_handle_t *handle, uint8_t row, uint8_t col, uint16_t *times)
+{
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    if ((row >= handle->row) || (col >= handle->col))                       /* check row and col */
+    {
+        handle->debug_print("multi_button: row or col is invalid.\n");      /* row or col is invalid */
+        
+        return 4;                                                           /* return error */
     }
     
-    return 0;                                                                                           /* success return 0 */
+    *times = handle->button[handle->col * row + col].max_click;             /* get max click */
+    
+    return 0;                                                               /* success return 0 */
 }
 
 /**
- * @brief     initialize the chip
+ * @brief     enable or disable the speculative click
  * @param[in] *handle pointer to a multi_button handle structure
- * @param[in] row max row of buttons
- * @param[in] col max col of buttons
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 gpio initialization failed
  *            - 2 handle is NULL
- *            - 3 linked functions is NULL
- *            - 4 row or col is invalid
- *            - 5 matrix init failed
- * @note      none
+ *            - 3 handle is not initialized
+ * @note      a tentative click is reported at the first release with a new gesture id,
+ *            then the same id is reported with a confirm, an upgrade or a retract event
  */
-uint8_t multi_button_init(multi_button_handle_t *handle, uint8_t row, uint8_t col)
+uint8_t multi_button_set_speculative(multi_button_handle_t *handle, multi_button_bool_t enable)
 {
-    uint8_t res;
-    uint8_t i;
-    uint8_t j;
-    uint16_t offset;
-    multi_button_time_t t;
-    
-    if (handle == NULL)                                                                     /* check handle */
+    if (handle == NULL)                         /* check handle */
     {
-        return 2;                                                                           /* return error */
+        return 2;                               /* return error */
     }
-    if (handle->debug_print == NULL)                                                        /* check debug_print */
+    if (handle->inited != 1)                    /* check handle initialization */
     {
-        return 3;                                                                           /* return error */
+        return 3;                               /* return error */
     }
     
-    if (row == 0)                                                                           /* check row */
+    handle->speculative = (uint8_t)enable;      /* set speculative */
+    
+    return 0;                                   /* success return 0 */
+}
+
+/**
+ * @brief      get the speculative click status
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_speculative(multi_button_handle_t *handle, multi_button_bool_t *enable)
+{
+    if (handle == NULL)                                         /* check handle */
     {
-        handle->debug_print("multi_button: row can't be 0.\n");                             /* row can't be 0 */
-        
-        return 4;                                                                           /* return error */
+        return 2;                                               /* return error */
     }
-    if (col == 0)                                                                           /* check col */
+    if (handle->inited != 1)                                    /* check handle initialization */
     {
-        handle->debug_print("multi_button: col can't be 0.\n");                             /* col can't be 0 */
-        
-        return 4;                                                                           /* return error */
+        return 3;                                               /* return error */
     }
-    if (row > 32)                                                                           /* check row */
+    
+    *enable = (multi_button_bool_t)(handle->speculative);       /* get speculative */
+    
+    return 0;                                                   /* success return 0 */
+}
+
+#endif
+
+/**
+ * @brief      get the debounced down state bitmap
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *rows pointer to a bitmap buffer with one word per row
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       bit n of rows[m] is set when the button at row m and col n is down
+ */
+uint8_t multi_button_get_state_bitmap(multi_button_handle_t *handle, uint32_t *rows)
+{
+    uint8_t i;
+    
+    if (handle == NULL)                                 /* check handle */
     {
-        handle->debug_print("multi_button: row > 32.\n");                                   /* row > 32 */
-        
-        return 4;                                                                           /* return error */
+        return 2;                                       /* return error */
     }
-    if (col > 32)                                                                           /* check col */
+    if (handle->inited != 1)                            /* check handle initialization */
     {
-        handle->debug_print("multi_button: col > 32.\n");                                   /* col > 32 */
-        
-        return 4;                                                                           /* return error */
+        return 3;                                       /* return error */
     }
-    if (row * col > MULTI_BUTTON_NUMBER)                                                    /* check row and col size */
+    
+    for (i = 0; i < handle->row; i++)                   /* loop row */
     {
-        handle->debug_print("multi_button: row * col > %d.\n", MULTI_BUTTON_NUMBER);        /* row * col > MULTI_BUTTON_NUMBER */
-        
-        return 4;                                                                           /* return error */
+        rows[i] = handle->state[i];                     /* copy the row state */
     }
     
-    if (handle->matrix_init == NULL)                                                        /* check matrix_init */
+    return 0;                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the debounced down state of a button
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[in]  row button row
+ * @param[in]  col button col
+ * @param[out] *pressed pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 row or col is invalid
+ * @note       none
+ */
+uint8_t multi_button_get_state(multi_button_handle_t *handle, uint8_t row, uint8_t col, multi_button_bool_t *pressed)
+{
+    if (handle == NULL)                                                                 /* check handle */
     {
-        handle->debug_print("multi_button: matrix_init is null.\n");                        /* matrix_init is null */
-        
-        return 3;                                                                           /* return error */
+        return 2;                                                                       /* return error */
     }
-    if (handle->matrix_deinit == NULL)                                                      /* check matrix_deinit */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        handle->debug_print("multi_button: matrix_deinit is null.\n");                      /* matrix_deinit is null */
-        
-        return 3;                                                                           /* return error */
+        return 3;                                                                       /* return error */
     }
-    if (handle->matrix_write_row == NULL)                                                   /* check matrix_write_row */
+    if ((row >= handle->row) || (col >= handle->col))                                   /* check row and col */
     {
-        handle->debug_print("multi_button: matrix_write_row is null.\n");                   /* matrix_write_row is null */
+        handle->debug_print("multi_button: row or col is invalid.\n");                  /* row or col is invalid */
         
-        return 3;                                                                           /* return error */
+        return 4;                                                                       /* return error */
     }
-    if (handle->matrix_read_row == NULL)                                                    /* check matrix_read_row */
+    
+    *pressed = (multi_button_bool_t)((handle->state[row] >> col) & 0x01);               /* get down state */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+
+/**
+ * @brief     set the long press hold min interval
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] us min interval in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      0 means a hold event in every period,
+ *            otherwise the skipped holds are counted in times of the next hold event,
+ *            times of a hold event is the number of the other holds coalesced into it in all modes,
+ *            the skipped holds left at the release are reported in one hold before the release
+ */
+uint8_t multi_button_set_hold_interval(multi_button_handle_t *handle, uint32_t us)
+{
+    if (handle == NULL)                 /* check handle */
     {
-        handle->debug_print("multi_button: matrix_read_row is null.\n");                    /* matrix_read_row is null */
-        
-        return 3;                                                                           /* return error */
+        return 2;                       /* return error */
     }
-    if (handle->timestamp_read == NULL)                                                     /* check timestamp_read */
+    if (handle->inited != 1)            /* check handle initialization */
     {
-        handle->debug_print("multi_button: timestamp_read is null.\n");                     /* timestamp_read is null */
-        
-        return 3;                                                                           /* return error */
+        return 3;                       /* return error */
     }
-    if (handle->delay_ms == NULL)                                                           /* check delay_ms */
+    
+    handle->hold_interval = us;         /* set hold interval */
+    
+    return 0;                           /* success return 0 */
+}
+
+/**
+ * @brief      get the long press hold min interval
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *us pointer to a min interval buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_hold_interval(multi_button_handle_t *handle, uint32_t *us)
+{
+    if (handle == NULL)                 /* check handle */
     {
-        handle->debug_print("multi_button: delay_ms is null.\n");                           /* delay_ms is null */
-        
-        return 3;                                                                           /* return error */
+        return 2;                       /* return error */
     }
-    if (handle->receive_callback == NULL)                                                   /* check receive_callback */
+    if (handle->inited != 1)            /* check handle initialization */
     {
-        handle->debug_print("multi_button: receive_callback is null.\n");                   /* receive_callback is null */
-        
-        return 3;                                                                           /* return error */
+        return 3;                       /* return error */
     }
     
-    handle->row = row;                                                                      /* set row */
-    handle->col = col;                                                                      /* set col */
-    res = handle->timestamp_read(&t);                                                       /* timestamp read */
-    if (res != 0)                                                                           /* check result */
-    {
-        handle->debug_print("multi_button: timestamp read failed.\n");                      /* timestamp read failed */
-        
-        return 1;                                                                           /* return error */
-    }
-    handle->check_time.s = t.s;                                                             /* save the current s */
-    handle->check_time.us = t.us;                                                           /* save the current us */
-    a_multi_button_set_param(handle);                                                       /* set params */
-    for (i = 0; i < row; i++)                                                               /* loop row */
+    *us = handle->hold_interval;        /* get hold interval */
+    
+    return 0;                           /* success return 0 */
+}
+
+/**
+ * @brief      get the coalesced long press hold count
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *cnt pointer to a count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_coalesce_count(multi_button_handle_t *handle, uint32_t *cnt)
+{
+    if (handle == NULL)                 /* check handle */
     {
-        for (j = 0; j < col; j++)                                                           /* loop col */
-        {
-            offset = handle->row * i + j;                                                   /* get offset */
-            a_multi_button_reset(handle, row, col);                                         /* reset all */
-            memset(&handle->button[offset], 0, sizeof(multi_button_single_t));              /* clear button */
-            handle->button[offset].cnt = 0;                                                 /* init cnt 0 */
-            handle->button[offset].level = 1;                                               /* init level high */
-            handle->button[offset].last_time.s = t.s;                                       /* save last time */
-            handle->button[offset].last_time.us = t.us;                                     /* save last time */
-        }
+        return 2;                       /* return error */
     }
-    res = handle->matrix_init();                                                            /* matrix init */
-    if (res != 0)                                                                           /* check the result */
+    if (handle->inited != 1)            /* check handle initialization */
     {
-        handle->debug_print("multi_button: matrix init failed.\n");                         /* matrix init failed */
-        
-        return 5;                                                                           /* return error */
+        return 3;                       /* return error */
     }
     
-    handle->inited = 1;                                                                     /* flag inited */
+    *cnt = handle->coalesce_cnt;        /* get coalesce count */
     
-    return 0;                                                                               /* success return 0 */
+    return 0;                           /* success return 0 */
 }
 
 /**
- * @brief     close the chip
+ * @brief     clear the coalesced long press hold count
  * @param[in] *handle pointer to a multi_button handle structure
  * @return    status code
  *            - 0 success
@@ -753,393 +2945,736 @@ uint8_t multi_button_init(multi_button_handle_t *handle, uint8_t row, uint8_t co
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t multi_button_deinit(multi_button_handle_t *handle)
+uint8_t multi_button_clear_coalesce_count(multi_button_handle_t *handle)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                      /* check handle */
+    if (handle == NULL)                 /* check handle */
     {
-        return 2;                                                            /* return error */
+        return 2;                       /* return error */
     }
-    if (handle->inited != 1)                                                 /* check handle initialization */
+    if (handle->inited != 1)            /* check handle initialization */
     {
-        return 3;                                                            /* return error */
+        return 3;                       /* return error */
     }
     
-    res = handle->matrix_deinit();                                           /* matrix deinit */
-    if (res != 0)                                                            /* check the result */
+    handle->coalesce_cnt = 0;           /* clear coalesce count */
+    
+    return 0;                           /* success return 0 */
+}
+
+#endif
+
+/**
+ * @brief      get the backward clock step count
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *cnt pointer to a count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       a step is counted each time timestamp_read returns a time earlier than the previous one
+ */
+uint8_t multi_button_get_clock_step_count(multi_button_handle_t *handle, uint32_t *cnt)
+{
+    if (handle == NULL)                 /* check handle */
     {
-        handle->debug_print("multi_button: matrix deinit failed.\n");        /* matrix deinit failed */
-        
-        return 1;                                                            /* return error */
+        return 2;                       /* return error */
+    }
+    if (handle->inited != 1)            /* check handle initialization */
+    {
+        return 3;                       /* return error */
     }
-    handle->inited = 0;                                                      /* flag close */
     
-    return 0;                                                                /* success return 0 */
+    *cnt = handle->clock_step_cnt;      /* get clock step count */
+    
+    return 0;                           /* success return 0 */
 }
 
 /**
- * @brief     set timeout
+ * @brief     clear the backward clock step count
  * @param[in] *handle pointer to a multi_button handle structure
- * @param[in] us set time
  * @return    status code
  *            - 0 success
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t multi_button_set_timeout(multi_button_handle_t *handle, uint32_t us)
+uint8_t multi_button_clear_clock_step_count(multi_button_handle_t *handle)
 {
-    if (handle == NULL)             /* check handle */
+    if (handle == NULL)                 /* check handle */
     {
-        return 2;                   /* return error */
+        return 2;                       /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (handle->inited != 1)            /* check handle initialization */
     {
-        return 3;                   /* return error */
+        return 3;                       /* return error */
     }
     
-    handle->timeout = us;           /* set timeout */
+    handle->clock_step_cnt = 0;         /* clear clock step count */
     
-    return 0;                       /* success return 0 */
+    return 0;                           /* success return 0 */
 }
 
+#if (MULTI_BUTTON_SUBSCRIBER_NUMBER > 0)
+
 /**
- * @brief      get timeout
+ * @brief      subscribe to events
  * @param[in]  *handle pointer to a multi_button handle structure
- * @param[out] *us pointer to a time buffer
+ * @param[in]  *key_mask pointer to a key bitmap with one word per row, NULL means all keys
+ * @param[in]  status_mask subscribed status mask
+ * @param[in]  *handler pointer to a handler function address
+ * @param[in]  *ctx handler context
+ * @param[out] *id pointer to a subscriber id buffer
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ *             - 4 handler or id is NULL
+ *             - 5 no free subscriber
+ * @note       bit n of key_mask[m] selects the button at row m and col n,
+ *             the handler is only called for the subscribed keys and status,
+ *             with the event ring enabled the handlers run in multi_button_event_pop and
+ *             multi_button_event_pop_batch of the consumer context, so subscribe from that context
  */
-uint8_t multi_button_get_timeout(multi_button_handle_t *handle, uint32_t *us)
+uint8_t multi_button_subscribe(multi_button_handle_t *handle, const uint32_t *key_mask, uint16_t status_mask,
+                               void (*handler)(void *ctx, const multi_button_event_t *event), void *ctx, uint8_t *id)
 {
-    if (handle == NULL)             /* check handle */
+    uint8_t i;
+    uint8_t j;
+    uint8_t k;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (handler == NULL)                                                                 /* check handler */
+    {
+        handle->debug_print("multi_button: handler is null.\n");                         /* handler is null */
+        
+        return 4;                                                                        /* return error */
+    }
+    if (id == NULL)                                                                      /* check id */
+    {
+        handle->debug_print("multi_button: id is null.\n");                              /* id is null */
+        
+        return 4;                                                                        /* return error */
+    }
+    
+    for (k = 0; k < MULTI_BUTTON_SUBSCRIBER_NUMBER; k++)                                 /* find a free subscriber */
+    {
+        if (handle->subscriber[k].handler == NULL)                                       /* if free */
+        {
+            break;                                                                       /* break */
+        }
+    }
+    if (k == MULTI_BUTTON_SUBSCRIBER_NUMBER)                                             /* check the result */
+    {
+        handle->debug_print("multi_button: no free subscriber.\n");                      /* no free subscriber */
+        
+        return 5;                                                                        /* return error */
+    }
+    handle->subscriber[k].handler = handler;                                             /* set handler */
+    handle->subscriber[k].ctx = ctx;                                                     /* set ctx */
+    for (i = 0; i < handle->row; i++)                                                    /* loop row */
+    {
+        for (j = 0; j < handle->col; j++)                                                /* loop col */
+        {
+            if ((key_mask == NULL) || (((key_mask[i] >> j) & 0x01) != 0))                /* if selected */
+            {
+                handle->button[handle->col * i + j].subscriber |= (uint32_t)1 << k;      /* add the key */
+            }
+        }
+    }
+    for (i = 0; i < 16; i++)                                                             /* loop all status */
+    {
+        if (((status_mask >> i) & 0x01) != 0)                                            /* if selected */
+        {
+            handle->subscriber_status[i] |= (uint32_t)1 << k;                            /* add the status */
+        }
+    }
+    *id = k;                                                                             /* set id */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     unsubscribe from events
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] id subscriber id
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 id is invalid
+ * @note      none
+ */
+uint8_t multi_button_unsubscribe(multi_button_handle_t *handle, uint8_t id)
+{
+    uint16_t i;
+    
+    if (handle == NULL)                                                                            /* check handle */
     {
-        return 2;                   /* return error */
+        return 2;                                                                                  /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (handle->inited != 1)                                                                       /* check handle initialization */
     {
-        return 3;                   /* return error */
+        return 3;                                                                                  /* return error */
+    }
+    if ((id >= MULTI_BUTTON_SUBSCRIBER_NUMBER) || (handle->subscriber[id].handler == NULL))        /* check id */
+    {
+        handle->debug_print("multi_button: id is invalid.\n");                                     /* id is invalid */
+        
+        return 4;                                                                                  /* return error */
     }
     
-    *us = handle->timeout;          /* get timeout */
+    for (i = 0; i < (uint16_t)(handle->row * handle->col); i++)                                    /* loop all buttons */
+    {
+        handle->button[i].subscriber &= ~((uint32_t)1 << id);                                      /* remove the key */
+    }
+    for (i = 0; i < 16; i++)                                                                       /* loop all status */
+    {
+        handle->subscriber_status[i] &= ~((uint32_t)1 << id);                                      /* remove the status */
+    }
+    handle->subscriber[id].handler = NULL;                                                         /* clear handler */
+    handle->subscriber[id].ctx = NULL;                                                             /* clear ctx */
     
-    return 0;                       /* success return 0 */
+    return 0;                                                                                      /* success return 0 */
 }
 
+#endif
+
+#if (MULTI_BUTTON_EVENT_RING_SIZE > 0)
+
 /**
- * @brief     set interval
+ * @brief     enable or disable the event ring
  * @param[in] *handle pointer to a multi_button handle structure
- * @param[in] us set time
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      when enabled, the scan only enqueues the events and the callbacks are not called
  */
-uint8_t multi_button_set_interval(multi_button_handle_t *handle, uint32_t us)
+uint8_t multi_button_set_event_ring(multi_button_handle_t *handle, multi_button_bool_t enable)
 {
-    if (handle == NULL)             /* check handle */
+    if (handle == NULL)                                 /* check handle */
     {
-        return 2;                   /* return error */
+        return 2;                                       /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (handle->inited != 1)                            /* check handle initialization */
     {
-        return 3;                   /* return error */
+        return 3;                                       /* return error */
     }
     
-    handle->interval = us;          /* set interval */
+    handle->event_ring_enable = (uint8_t)enable;        /* set event ring */
     
-    return 0;                       /* success return 0 */
+    return 0;                                           /* success return 0 */
 }
 
 /**
- * @brief      get interval
+ * @brief      get the event ring status
  * @param[in]  *handle pointer to a multi_button handle structure
- * @param[out] *us pointer to a time buffer
+ * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t multi_button_get_interval(multi_button_handle_t *handle, uint32_t *us)
+uint8_t multi_button_get_event_ring(multi_button_handle_t *handle, multi_button_bool_t *enable)
 {
-    if (handle == NULL)             /* check handle */
+    if (handle == NULL)                                                 /* check handle */
     {
-        return 2;                   /* return error */
+        return 2;                                                       /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (handle->inited != 1)                                            /* check handle initialization */
     {
-        return 3;                   /* return error */
+        return 3;                                                       /* return error */
     }
     
-    *us = handle->interval;         /* get interval */
+    *enable = (multi_button_bool_t)(handle->event_ring_enable);         /* get event ring */
     
-    return 0;                       /* success return 0 */
+    return 0;                                                           /* success return 0 */
 }
 
 /**
- * @brief     set short time
+ * @brief     set the event ring overflow policy
  * @param[in] *handle pointer to a multi_button handle structure
- * @param[in] us set time
+ * @param[in] policy overflow policy
  * @return    status code
  *            - 0 success
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t multi_button_set_short_time(multi_button_handle_t *handle, uint32_t us)
+uint8_t multi_button_set_event_overflow_policy(multi_button_handle_t *handle, multi_button_overflow_policy_t policy)
 {
-    if (handle == NULL)             /* check handle */
+    if (handle == NULL)                          /* check handle */
     {
-        return 2;                   /* return error */
+        return 2;                                /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (handle->inited != 1)                     /* check handle initialization */
     {
-        return 3;                   /* return error */
+        return 3;                                /* return error */
     }
     
-    handle->short_time = us;        /* set short time */
+    handle->event_policy = (uint8_t)policy;      /* set policy */
     
-    return 0;                       /* success return 0 */
+    return 0;                                    /* success return 0 */
 }
 
 /**
- * @brief      get short time
+ * @brief      get the event ring overflow policy
  * @param[in]  *handle pointer to a multi_button handle structure
- * @param[out] *us pointer to a time buffer
+ * @param[out] *policy pointer to an overflow policy buffer
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t multi_button_get_short_time(multi_button_handle_t *handle, uint32_t *us)
+uint8_t multi_button_get_event_overflow_policy(multi_button_handle_t *handle, multi_button_overflow_policy_t *policy)
 {
-    if (handle == NULL)             /* check handle */
+    if (handle == NULL)                                                 /* check handle */
     {
-        return 2;                   /* return error */
+        return 2;                                                       /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (handle->inited != 1)                                            /* check handle initialization */
     {
-        return 3;                   /* return error */
+        return 3;                                                       /* return error */
     }
     
-    *us = handle->short_time;       /* get short time */
+    *policy = (multi_button_overflow_policy_t)(handle->event_policy);   /* get policy */
     
-    return 0;                       /* success return 0 */
+    return 0;                                                           /* success return 0 */
 }
 
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+
 /**
- * @brief     set long time
+ * @brief     enable or disable the long press hold coalescing
  * @param[in] *handle pointer to a multi_button handle structure
- * @param[in] us set time
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      a hold is merged into the last queued hold of the key until that hold is popped,
+ *            times of the popped hold counts the merged holds, a count not popped at the release
+ *            is reported in one more hold before the release
  */
-uint8_t multi_button_set_long_time(multi_button_handle_t *handle, uint32_t us)
+uint8_t multi_button_set_hold_coalesce(multi_button_handle_t *handle, multi_button_bool_t enable)
 {
-    if (handle == NULL)             /* check handle */
+    if (handle == NULL)                           /* check handle */
     {
-        return 2;                   /* return error */
+        return 2;                                 /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (handle->inited != 1)                      /* check handle initialization */
     {
-        return 3;                   /* return error */
+        return 3;                                 /* return error */
     }
     
-    handle->long_time = us;         /* set long time */
+    handle->hold_coalesce = (uint8_t)enable;      /* set hold coalesce */
     
-    return 0;                       /* success return 0 */
+    return 0;                                     /* success return 0 */
 }
 
 /**
- * @brief      get long time
+ * @brief      get the long press hold coalescing status
  * @param[in]  *handle pointer to a multi_button handle structure
- * @param[out] *us pointer to a time buffer
+ * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t multi_button_get_long_time(multi_button_handle_t *handle, uint32_t *us)
+uint8_t multi_button_get_hold_coalesce(multi_button_handle_t *handle, multi_button_bool_t *enable)
 {
-    if (handle == NULL)             /* check handle */
+    if (handle == NULL)                                             /* check handle */
     {
-        return 2;                   /* return error */
+        return 2;                                                   /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (handle->inited != 1)                                        /* check handle initialization */
     {
-        return 3;                   /* return error */
+        return 3;                                                   /* return error */
     }
     
-    *us = handle->long_time;        /* get long time */
+    *enable = (multi_button_bool_t)(handle->hold_coalesce);         /* get hold coalesce */
     
-    return 0;                       /* success return 0 */
+    return 0;                                                       /* success return 0 */
 }
 
+#endif
+
 /**
- * @brief     set repeat time
- * @param[in] *handle pointer to a multi_button handle structure
- * @param[in] us set time
- * @return    status code
- *            - 0 success
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      pop an event from the event ring
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *event pointer to an event buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 ring is empty
+ * @note       only one consumer context can pop events,
+ *             the subscribers of the popped event run before it returns
  */
-uint8_t multi_button_set_repeat_time(multi_button_handle_t *handle, uint32_t us)
+uint8_t multi_button_event_pop(multi_button_handle_t *handle, multi_button_event_t *event)
 {
-    if (handle == NULL)             /* check handle */
+    uint16_t len;
+    uint8_t res;
+    
+    len = 1;                                                        /* pop one */
+    res = multi_button_event_pop_batch(handle, event, &len);        /* pop batch */
+    if (res != 0)                                                   /* check result */
     {
-        return 2;                   /* return error */
+        return res;                                                 /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (len == 0)                                                   /* check length */
     {
-        return 3;                   /* return error */
+        return 4;                                                   /* return error */
     }
     
-    handle->repeat_time = us;       /* set repeat time */
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief         pop events from the event ring
+ * @param[in]     *handle pointer to a multi_button handle structure
+ * @param[out]    *event pointer to an event buffer
+ * @param[in,out] *len pointer to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          len is the buffer length as input and the popped length as output,
+ *                only one consumer context can pop events,
+ *                the subscribers of the popped events run before it returns
+ */
+uint8_t multi_button_event_pop_batch(multi_button_handle_t *handle, multi_button_event_t *event, uint16_t *len)
+{
+    uint16_t i;
+    uint32_t head;
+    uint32_t tail;
     
-    return 0;                       /* success return 0 */
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    
+    tail = atomic_load_explicit(&handle->event_tail, memory_order_relaxed);                  /* get tail, only written here */
+    i = 0;                                                                                   /* init 0 */
+    while (i < *len)                                                                         /* loop the buffer */
+    {
+        head = atomic_load_explicit(&handle->event_head, memory_order_acquire);              /* get head */
+        if ((uint32_t)(head - tail) > MULTI_BUTTON_EVENT_RING_SIZE)                          /* the oldest are overwritten */
+        {
+            atomic_fetch_add_explicit(&handle->event_overflow, 
+                                      head - MULTI_BUTTON_EVENT_RING_SIZE - tail,
+                                      memory_order_relaxed);                                 /* count the dropped */
+            tail = head - MULTI_BUTTON_EVENT_RING_SIZE;                                      /* skip to the oldest kept */
+        }
+        if (tail == head)                                                                    /* check empty */
+        {
+            break;                                                                           /* break */
+        }
+        if (a_multi_button_event_read(&handle->event_ring[tail & (MULTI_BUTTON_EVENT_RING_SIZE - 1)],
+                                      tail, &event[i]) != 0)                                 /* read the event */
+        {
+            atomic_fetch_add_explicit(&handle->event_overflow, 1, memory_order_relaxed);    /* count the dropped */
+            tail++;                                                                          /* skip the overwritten */
+            
+            continue;                                                                        /* next */
+        }
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+        if (event[i].status == MULTI_BUTTON_STATUS_LONG_PRESS_HOLD)                          /* if hold */
+        {
+            a_multi_button_hold_take(handle, &event[i], tail);                               /* take the merged count */
+        }
+#endif
+        tail++;                                                                              /* tail++ */
+        i++;                                                                                 /* i++ */
+    }
+    atomic_store_explicit(&handle->event_tail, tail, memory_order_release);                  /* release the slots */
+    *len = i;                                                                                /* set length */
+#if (MULTI_BUTTON_SUBSCRIBER_NUMBER > 0)
+    for (i = 0; i < *len; i++)                                                               /* loop the popped events */
+    {
+        a_multi_button_dispatch(handle, handle->button[event[i].index].subscriber &
+                                handle->subscriber_status[a_multi_button_status_bit(event[i].status)],
+                                &event[i]);                                                  /* run the subscribers */
+    }
+#endif
+    
+    return 0;                                                                                /* success return 0 */
 }
 
 /**
- * @brief      get repeat time
+ * @brief      get the dropped event count of the event ring
  * @param[in]  *handle pointer to a multi_button handle structure
- * @param[out] *us pointer to a time buffer
+ * @param[out] *cnt pointer to a count buffer
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t multi_button_get_repeat_time(multi_button_handle_t *handle, uint32_t *us)
+uint8_t multi_button_get_event_overflow(multi_button_handle_t *handle, uint32_t *cnt)
 {
-    if (handle == NULL)             /* check handle */
+    if (handle == NULL)                                                          /* check handle */
     {
-        return 2;                   /* return error */
+        return 2;                                                                /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (handle->inited != 1)                                                     /* check handle initialization */
     {
-        return 3;                   /* return error */
+        return 3;                                                                /* return error */
     }
     
-    *us = handle->repeat_time;      /* get repeat time */
+    *cnt = atomic_load_explicit(&handle->event_overflow, memory_order_relaxed);  /* get overflow */
     
-    return 0;                       /* success return 0 */
+    return 0;                                                                    /* success return 0 */
 }
 
 /**
- * @brief     set repeat cnt
+ * @brief     clear the dropped event count of the event ring
  * @param[in] *handle pointer to a multi_button handle structure
- * @param[in] cnt set repeat counter
  * @return    status code
  *            - 0 success
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t multi_button_set_repeat_cnt(multi_button_handle_t *handle, uint32_t cnt)
+uint8_t multi_button_clear_event_overflow(multi_button_handle_t *handle)
 {
-    if (handle == NULL)             /* check handle */
+    if (handle == NULL)                                                          /* check handle */
     {
-        return 2;                   /* return error */
+        return 2;                                                                /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (handle->inited != 1)                                                     /* check handle initialization */
     {
-        return 3;                   /* return error */
+        return 3;                                                                /* return error */
     }
     
-    handle->repeat_cnt = cnt;       /* set repeat cnt */
+    atomic_store_explicit(&handle->event_overflow, 0, memory_order_relaxed);    /* clear overflow */
     
-    return 0;                       /* success return 0 */
+    return 0;                                                                    /* success return 0 */
 }
 
+#endif
+
 /**
- * @brief      get repeat cnt
- * @param[in]  *handle pointer to a multi_button handle structure
- * @param[out] *cnt pointer to a counter buffer
- * @return     status code
- *             - 0 success
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     initialize the manager
+ * @param[in] *manager pointer to a multi_button manager structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 manager is NULL
+ * @note      none
  */
-uint8_t multi_button_get_repeat_cnt(multi_button_handle_t *handle, uint32_t *cnt)
+uint8_t multi_button_manager_init(multi_button_manager_t *manager)
 {
-    if (handle == NULL)             /* check handle */
+    if (manager == NULL)                                          /* check manager */
     {
-        return 2;                   /* return error */
+        return 2;                                                 /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    
+    memset(manager, 0, sizeof(multi_button_manager_t));           /* clear the manager */
+    
+    return 0;                                                     /* success return 0 */
+}
+
+/**
+ * @brief     add a handle to the manager
+ * @param[in] *manager pointer to a multi_button manager structure
+ * @param[in] *handle pointer to an initialized multi_button handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 manager or handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 manager is full
+ *            - 5 handle is already added
+ * @note      the row lines of the handles must be independent,
+ *            one manager holds at most MULTI_BUTTON_MANAGER_NUMBER handles
+ */
+uint8_t multi_button_manager_add(multi_button_manager_t *manager, multi_button_handle_t *handle)
+{
+    uint8_t i;
+    
+    if ((manager == NULL) || (handle == NULL))                    /* check manager and handle */
     {
-        return 3;                   /* return error */
+        return 2;                                                 /* return error */
     }
+    if (handle->inited != 1)                                      /* check handle initialization */
+    {
+        return 3;                                                 /* return error */
+    }
+    if (manager->num >= MULTI_BUTTON_MANAGER_NUMBER)              /* check the number */
+    {
+        handle->debug_print("multi_button: manager is full.\n");  /* manager is full */
+        
+        return 4;                                                 /* return error */
+    }
+    for (i = 0; i < manager->num; i++)                            /* loop all handles */
+    {
+        if (manager->handle[i] == handle)                         /* check the handle */
+        {
+            return 5;                                             /* return error */
+        }
+    }
+    manager->handle[manager->num] = handle;                       /* add the handle */
+    manager->num++;                                               /* num++ */
     
-    *cnt = handle->repeat_cnt;      /* get repeat cnt */
-    
-    return 0;                       /* success return 0 */
+    return 0;                                                     /* success return 0 */
 }
 
 /**
- * @brief     set period
+ * @brief     remove a handle from the manager
+ * @param[in] *manager pointer to a multi_button manager structure
  * @param[in] *handle pointer to a multi_button handle structure
- * @param[in] period set period
  * @return    status code
  *            - 0 success
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
+ *            - 2 manager or handle is NULL
+ *            - 4 handle is not found
  * @note      none
  */
-uint8_t multi_button_set_period(multi_button_handle_t *handle, uint32_t period)
+uint8_t multi_button_manager_remove(multi_button_manager_t *manager, multi_button_handle_t *handle)
 {
-    if (handle == NULL)             /* check handle */
+    uint8_t i;
+    
+    if ((manager == NULL) || (handle == NULL))                    /* check manager and handle */
     {
-        return 2;                   /* return error */
+        return 2;                                                 /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    
+    for (i = 0; i < manager->num; i++)                            /* loop all handles */
     {
-        return 3;                   /* return error */
+        if (manager->handle[i] == handle)                         /* find the handle */
+        {
+            break;                                                /* break */
+        }
     }
+    if (i == manager->num)                                        /* check the result */
+    {
+        return 4;                                                 /* return error */
+    }
+    for (; i < manager->num - 1; i++)                             /* keep the order */
+    {
+        manager->handle[i] = manager->handle[i + 1];              /* move forward */
+    }
+    manager->num--;                                               /* num-- */
+    manager->handle[manager->num] = NULL;                         /* clear the last */
     
-    handle->period = period;        /* set period */
-    
-    return 0;                       /* success return 0 */
+    return 0;                                                     /* success return 0 */
 }
 
 /**
- * @brief      get period
- * @param[in]  *handle pointer to a multi_button handle structure
- * @param[out] *period pointer to a period buffer
- * @return     status code
- *             - 0 success
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     process all handles of the manager
+ * @param[in] *manager pointer to a multi_button manager structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 manager is NULL
+ *            - 4 manager is empty
+ * @note      the same row of all handles is selected together and shares one settle delay,
+ *            the events of each handle keep the order of multi_button_process,
+ *            a failed handle is skipped for the rest of the pass and the others go on,
+ *            all the handles run in the calling thread, there is no worker pool,
+ *            the driver keeps no global state, so managers with different handles
+ *            can be processed in parallel from the threads of the caller
  */
-uint8_t multi_button_get_period(multi_button_handle_t *handle, uint32_t *period)
+uint8_t multi_button_manager_process(multi_button_manager_t *manager)
 {
-    if (handle == NULL)             /* check handle */
+    uint8_t i;
+    uint8_t r;
+    uint8_t row;
+    uint8_t settle;
+    uint32_t failed;
+    int64_t diff[MULTI_BUTTON_MANAGER_NUMBER];
+    multi_button_time_t t[MULTI_BUTTON_MANAGER_NUMBER];
+    multi_button_handle_t *handle;
+    
+    if (manager == NULL)                                                                    /* check manager */
     {
-        return 2;                   /* return error */
+        return 2;                                                                           /* return error */
     }
-    if (handle->inited != 1)        /* check handle initialization */
+    if (manager->num == 0)                                                                  /* check the number */
     {
-        return 3;                   /* return error */
+        return 4;                                                                           /* return error */
     }
     
-    *period = handle->period;       /* get period */
+    failed = 0;                                                                             /* init 0 */
+    row = 0;                                                                                /* init 0 */
+    for (i = 0; i < manager->num; i++)                                                      /* begin all scans */
+    {
+        handle = manager->handle[i];                                                        /* get the handle */
+        if ((handle->inited != 1) ||
+            (a_multi_button_scan_begin(handle, &t[i], &diff[i]) != 0))                      /* begin the scan */
+        {
+            failed |= (uint32_t)1 << i;                                                     /* mark failed */
+            
+            continue;                                                                       /* skip the handle */
+        }
+        if (handle->row > row)                                                              /* check the row */
+        {
+            row = handle->row;                                                              /* max row */
+        }
+    }
+    for (r = 0; r < row; r++)                                                               /* loop all row */
+    {
+        settle = MULTI_BUTTON_MANAGER_NUMBER;                                               /* no selected handle */
+        for (i = 0; i < manager->num; i++)                                                  /* select the row of all handles */
+        {
+            handle = manager->handle[i];                                                    /* get the handle */
+            if (((failed >> i) & 0x1) || (r >= handle->row))                                /* skip the handle */
+            {
+                continue;                                                                   /* next */
+            }
+            if (a_multi_button_select_row(handle, r) != 0)                                  /* select the row */
+            {
+                failed |= (uint32_t)1 << i;                                                 /* mark failed */
+                
+                continue;                                                                   /* next */
+            }
+            if (settle == MULTI_BUTTON_MANAGER_NUMBER)                                      /* first selected handle */
+            {
+                settle = i;                                                                 /* save the index */
+            }
+        }
+        if (settle == MULTI_BUTTON_MANAGER_NUMBER)                                          /* no selected handle */
+        {
+            continue;                                                                       /* next row */
+        }
+        a_multi_button_delay_ms(manager->handle[settle], 1);                                /* one settle delay */
+        for (i = 0; i < manager->num; i++)                                                  /* read the row of all handles */
+        {
+            handle = manager->handle[i];                                                    /* get the handle */
+            if (((failed >> i) & 0x1) || (r >= handle->row))                                /* skip the handle */
+            {
+                continue;                                                                   /* next */
+            }
+            if (a_multi_button_scan_row(handle, r, &t[i], diff[i]) != 0)                    /* scan the row */
+            {
+                failed |= (uint32_t)1 << i;                                                 /* mark failed */
+            }
+        }
+    }
+#if (MULTI_BUTTON_BATCH_LENGTH > 0)
+    for (i = 0; i < manager->num; i++)                                                      /* loop all handles */
+    {
+        if (manager->handle[i]->inited == 1)                                                /* check handle initialization */
+        {
+            a_multi_button_batch_flush(manager->handle[i]);                                 /* deliver the batched events */
+        }
+    }
+#endif
     
-    return 0;                       /* success return 0 */
+    return (failed != 0) ? 1 : 0;                                                           /* return the result */
 }
 
 /**
@@ -39,6 +39,7 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <stddef.h>
 #include <string.h>
 
 #ifdef __cplusplus
@@ -58,25 +59,135 @@ extern "C"{
 
 /**
  * @brief multi_button max number definition
+ * @note  it is the inline storage of each handle used by multi_button_init,
+ *        a build that only uses multi_button_init_with_buffer can set it to 0
+ *        and keep the buttons out of the handle
  */
 #ifndef MULTI_BUTTON_NUMBER
     #define MULTI_BUTTON_NUMBER        128          /**< max 128 number */
 #endif
 
 /**
- * @brief multi_button each length definition
+ * @brief multi_button max row definition
+ * @note  1 - 32, it sizes the row bitmaps of each handle,
+ *        a build with fewer rows can lower it to save ram
  */
-#ifndef MULTI_BUTTON_EACH_LENGTH
-    #define MULTI_BUTTON_EACH_LENGTH      16          /**< 16 */
+#ifndef MULTI_BUTTON_ROW_NUMBER
+    #define MULTI_BUTTON_ROW_NUMBER    32           /**< max 32 rows */
 #endif
 
 /**
  * @brief check range
  */
-#if (MULTI_BUTTON_EACH_LENGTH < 8)
-    #error "MULTI_BUTTON_EACH_LENGTH < 8"
+#if (MULTI_BUTTON_ROW_NUMBER < 1) || (MULTI_BUTTON_ROW_NUMBER > 32)
+    #error "MULTI_BUTTON_ROW_NUMBER is invalid"
 #endif
 
+/**
+ * @brief multi_button gesture feature definition
+ * @note  0 compiles the gesture class out with its fields and functions
+ */
+#ifndef MULTI_BUTTON_FEATURE_CLICK
+    #define MULTI_BUTTON_FEATURE_CLICK             1          /**< single, double, triple, repeat and speculative click */
+#endif
+#ifndef MULTI_BUTTON_FEATURE_SHORT_PRESS
+    #define MULTI_BUTTON_FEATURE_SHORT_PRESS       1          /**< short press start and end */
+#endif
+#ifndef MULTI_BUTTON_FEATURE_LONG_PRESS
+    #define MULTI_BUTTON_FEATURE_LONG_PRESS        1          /**< long press start, hold and end */
+#endif
+#ifndef MULTI_BUTTON_FEATURE_TYPEMATIC
+    #define MULTI_BUTTON_FEATURE_TYPEMATIC         1          /**< typematic repeat */
+#endif
+
+/**
+ * @brief multi_button batch length definition
+ * @note  0 means no batch delivery, a scan with more events than the length delivers them in several batches
+ */
+#ifndef MULTI_BUTTON_BATCH_LENGTH
+    #define MULTI_BUTTON_BATCH_LENGTH        0          /**< no batch delivery */
+#endif
+
+/**
+ * @brief check range
+ */
+#if (MULTI_BUTTON_BATCH_LENGTH < 0) || (MULTI_BUTTON_BATCH_LENGTH > 0xFFFF)
+    #error "MULTI_BUTTON_BATCH_LENGTH is invalid"
+#endif
+
+/**
+ * @brief multi_button subscriber number definition
+ * @note  0 means no subscription table, 1 - 32 adds the table and a subscriber mask to each button
+ */
+#ifndef MULTI_BUTTON_SUBSCRIBER_NUMBER
+    #define MULTI_BUTTON_SUBSCRIBER_NUMBER        0          /**< no subscription table */
+#endif
+
+/**
+ * @brief check range
+ */
+#if (MULTI_BUTTON_SUBSCRIBER_NUMBER > 32)
+    #error "MULTI_BUTTON_SUBSCRIBER_NUMBER > 32"
+#endif
+
+/**
+ * @brief multi_button event ring length definition
+ * @note  0 means no event ring, otherwise it must be a power of 2 up to 16384 and needs C11 atomics
+ */
+#ifndef MULTI_BUTTON_EVENT_RING_SIZE
+    #define MULTI_BUTTON_EVENT_RING_SIZE        0          /**< no event ring */
+#endif
+
+/**
+ * @brief check range
+ */
+#if (MULTI_BUTTON_EVENT_RING_SIZE & (MULTI_BUTTON_EVENT_RING_SIZE - 1)) != 0
+    #error "MULTI_BUTTON_EVENT_RING_SIZE is not a power of 2"
+#endif
+#if (MULTI_BUTTON_EVENT_RING_SIZE > 16384)
+    #error "MULTI_BUTTON_EVENT_RING_SIZE > 16384"
+#endif
+#if (MULTI_BUTTON_EVENT_RING_SIZE > 0)
+    #if !defined(__STDC_VERSION__) || (__STDC_VERSION__ < 201112L) || defined(__STDC_NO_ATOMICS__)
+        #error "MULTI_BUTTON_EVENT_RING_SIZE needs C11 atomics"
+    #endif
+    #include <stdatomic.h>
+#endif
+
+/**
+ * @brief multi_button manager handle number definition
+ * @note  1 - 32, a process pass marks the failed handles in one 32 bit mask,
+ *        more panels need more managers
+ */
+#ifndef MULTI_BUTTON_MANAGER_NUMBER
+    #define MULTI_BUTTON_MANAGER_NUMBER        16          /**< 16 handles */
+#endif
+
+/**
+ * @brief check range
+ */
+#if (MULTI_BUTTON_MANAGER_NUMBER < 1) || (MULTI_BUTTON_MANAGER_NUMBER > 32)
+    #error "MULTI_BUTTON_MANAGER_NUMBER is invalid"
+#endif
+
+/**
+ * @brief multi_button bool enumeration definition
+ */
+typedef enum
+{
+    MULTI_BUTTON_BOOL_FALSE = 0x00,        /**< disable function */
+    MULTI_BUTTON_BOOL_TRUE  = 0x01,        /**< enable function */
+} multi_button_bool_t;
+
+/**
+ * @brief multi_button overflow policy enumeration definition
+ */
+typedef enum
+{
+    MULTI_BUTTON_OVERFLOW_DROP_NEWEST = 0x00,        /**< drop the newest event */
+    MULTI_BUTTON_OVERFLOW_DROP_OLDEST = 0x01,        /**< drop the oldest event */
+} multi_button_overflow_policy_t;
+
 /**
  * @brief multi_button status enumeration definition
  */
@@ -93,6 +204,11 @@ typedef enum
     MULTI_BUTTON_STATUS_LONG_PRESS_START  = (1 << 8),        /**< long press start */
     MULTI_BUTTON_STATUS_LONG_PRESS_HOLD   = (1 << 9),        /**< long press hold */
     MULTI_BUTTON_STATUS_LONG_PRESS_END    = (1 << 10),       /**< long press end */
+    MULTI_BUTTON_STATUS_TYPEMATIC         = (1 << 11),       /**< typematic repeat */
+    MULTI_BUTTON_STATUS_CLICK_TENTATIVE   = (1 << 12),       /**< speculative click */
+    MULTI_BUTTON_STATUS_CLICK_CONFIRM     = (1 << 13),       /**< speculative click confirmed as single click */
+    MULTI_BUTTON_STATUS_CLICK_UPGRADE     = (1 << 14),       /**< speculative click upgraded to multi click */
+    MULTI_BUTTON_STATUS_CLICK_RETRACT     = (1 << 15),       /**< speculative click retracted */
 } multi_button_status_t;
 
 /**
@@ -102,6 +218,7 @@ typedef struct multi_button_s
 {
     uint16_t status;       /**< status */
     uint16_t times;        /**< times */
+    uint32_t id;           /**< speculative gesture id, 0 means none */
 } multi_button_t;
 
 /**
@@ -114,13 +231,40 @@ typedef struct multi_button_time_s
 } multi_button_time_t;
 
 /**
- * @brief multi_button decode structure definition
+ * @brief multi_button event structure definition
+ */
+typedef struct multi_button_event_s
+{
+    multi_button_time_t t;        /**< event timestamp */
+    uint32_t duration_us;         /**< press or hold duration in us */
+    uint32_t seq;                 /**< sequence number */
+    uint16_t index;               /**< button index */
+    uint8_t row;                  /**< button row */
+    uint8_t col;                  /**< button col */
+    uint16_t status;              /**< status */
+    uint16_t times;               /**< times */
+    uint32_t id;                  /**< speculative gesture id, 0 means none */
+} multi_button_event_t;
+
+#if (MULTI_BUTTON_EVENT_RING_SIZE > 0)
+/**
+ * @brief multi_button event ring slot structure definition
+ */
+typedef struct multi_button_event_slot_s
+{
+    _Atomic uint32_t seq;                                                /**< ring position of the stored event */
+    _Atomic uint32_t word[(sizeof(multi_button_event_t) + 3) / 4];       /**< stored event words */
+} multi_button_event_slot_t;
+#endif
+
+/**
+ * @brief multi_button subscriber structure definition
  */
-typedef struct multi_button_decode_s
+typedef struct multi_button_subscriber_s
 {
-    multi_button_time_t t;        /**< timestamp */
-    uint32_t diff_us;             /**< diff us */
-} multi_button_decode_t;
+    void (*handler)(void *ctx, const multi_button_event_t *event);        /**< point to a handler function address */
+    void *ctx;                                                            /**< handler context */
+} multi_button_subscriber_t;
 
 /**
  * @brief multi_button single structure definition
@@ -128,12 +272,40 @@ typedef struct multi_button_decode_s
 typedef struct multi_button_single_s
 {
     multi_button_time_t last_time;                                 /**< last time */
-    multi_button_decode_t decode[MULTI_BUTTON_EACH_LENGTH];        /**< decode buffer */
-    uint16_t decode_len;                                           /**< decode length */
+    multi_button_time_t press_time;                                /**< last press edge time */
+    multi_button_time_t edge_time;                                 /**< edge time of the pending change */
+    uint32_t hold_us;                                              /**< last press duration */
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+    multi_button_time_t hold_time;                                 /**< last long press hold time */
+    uint16_t hold_times;                                           /**< pending long press hold times */
+#if (MULTI_BUTTON_EVENT_RING_SIZE > 0)
+    uint32_t hold_pos;                                             /**< ring position of the last queued hold */
+    _Atomic uint32_t hold_merge;                                   /**< open flag, position and count merged into the queued hold */
+#endif
+#endif
+#if (MULTI_BUTTON_FEATURE_TYPEMATIC != 0)
+    multi_button_time_t typematic_time;                            /**< typematic deadline */
+    uint32_t typematic_interval;                                   /**< typematic current interval */
+    uint16_t typematic_times;                                      /**< typematic times */
+    uint8_t typematic_armed;                                       /**< typematic armed */
+#endif
+    uint16_t gesture;                                              /**< enabled gesture mask */
+#if (MULTI_BUTTON_FEATURE_CLICK != 0)
+    uint16_t max_click;                                            /**< max click times */
+    uint32_t speculative_id;                                       /**< pending speculative gesture id */
+#endif
+#if (MULTI_BUTTON_SUBSCRIBER_NUMBER > 0)
+    uint32_t subscriber;                                           /**< subscriber mask */
+#endif
+    uint16_t times;                                                /**< press times of the current gesture */
+    uint8_t pressed;                                               /**< pressed in the current gesture */
+#if (MULTI_BUTTON_FEATURE_SHORT_PRESS != 0)
     uint8_t short_triggered;                                       /**< short triggered */
+#endif
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
     uint8_t long_triggered;                                        /**< long triggered */
-    uint8_t level;                                                 /**< gpio level */
-    uint8_t cnt;                                                   /**< detect times */
+#endif
+    uint8_t cnt;                                                   /**< debounce count, only used while the key is pending */
 } multi_button_single_t;
 
 /**
@@ -141,28 +313,106 @@ typedef struct multi_button_single_s
  */
 typedef struct multi_button_handle_s
 {
-    uint8_t (*matrix_init)(void);                                                      /**< point to a matrix_init function address */
-    uint8_t (*matrix_deinit)(void);                                                    /**< point to a matrix_deinit function address */
-    uint8_t (*matrix_write_row)(uint16_t num, uint8_t level);                          /**< point to a matrix_write_row function address */
-    uint8_t (*matrix_read_row)(uint32_t *col_array);                                   /**< point to a matrix_read_row function address */
-    uint8_t (*timestamp_read)(multi_button_time_t *t);                                 /**< point to a timestamp_read function address */
-    void (*delay_ms)(uint32_t ms);                                                     /**< point to a delay_ms function address */
-    void (*debug_print)(const char *const fmt, ...);                                   /**< point to a debug_print function address */
-    void (*receive_callback)(uint16_t row, uint16_t col, multi_button_t *data);        /**< point to a receive_callback function address */
-    multi_button_single_t button[MULTI_BUTTON_NUMBER];                                 /**< buttons */
-    multi_button_time_t check_time;                                                    /**< check time */
-    uint8_t inited;                                                                    /**< inited flag */
-    uint8_t row;                                                                       /**< row */
-    uint8_t col;                                                                       /**< col */
-    uint32_t short_time;                                                               /**< short time */
-    uint32_t long_time;                                                                /**< long time */
-    uint32_t repeat_time;                                                              /**< repeat time */
-    uint32_t interval;                                                                 /**< interval */
-    uint32_t timeout;                                                                  /**< timeout */
-    uint32_t repeat_cnt;                                                               /**< repeat cnt */
-    uint32_t period;                                                                   /**< period */
+    uint8_t (*matrix_init)(void);                                                                   /**< point to a matrix_init function address */
+    uint8_t (*matrix_deinit)(void);                                                                 /**< point to a matrix_deinit function address */
+    uint8_t (*matrix_write_row)(uint16_t num, uint8_t level);                                       /**< point to a matrix_write_row function address */
+    uint8_t (*matrix_read_row)(uint32_t *col_array);                                                /**< point to a matrix_read_row function address */
+    uint8_t (*timestamp_read)(multi_button_time_t *t);                                              /**< point to a timestamp_read function address */
+    void (*delay_ms)(uint32_t ms);                                                                  /**< point to a delay_ms function address */
+    void (*debug_print)(const char *const fmt, ...);                                                /**< point to a debug_print function address */
+    void (*receive_callback)(uint16_t row, uint16_t col, multi_button_t *data);                     /**< point to a receive_callback function address */
+    void (*receive_event_callback)(void *user, multi_button_event_t *event);                        /**< point to a receive_event_callback function address */
+    uint8_t (*matrix_select_row)(uint16_t row);                                                     /**< point to a matrix_select_row function address */
+    uint8_t (*matrix_read_row_timestamp)(uint32_t *col_array, multi_button_time_t *t);              /**< point to a matrix_read_row_timestamp function address */
+#if (MULTI_BUTTON_BATCH_LENGTH > 0)
+    void (*receive_batch_callback)(void *user, const multi_button_event_t *event, size_t n);        /**< point to a receive_batch_callback function address */
+#endif
+    uint8_t (*matrix_init_ex)(void *user);                                                          /**< point to a matrix_init_ex function address */
+    uint8_t (*matrix_deinit_ex)(void *user);                                                        /**< point to a matrix_deinit_ex function address */
+    uint8_t (*matrix_write_row_ex)(void *user, uint16_t num, uint8_t level);                        /**< point to a matrix_write_row_ex function address */
+    uint8_t (*matrix_read_row_ex)(void *user, uint32_t *col_array);                                 /**< point to a matrix_read_row_ex function address */
+    uint8_t (*timestamp_read_ex)(void *user, multi_button_time_t *t);                               /**< point to a timestamp_read_ex function address */
+    void (*delay_ms_ex)(void *user, uint32_t ms);                                                   /**< point to a delay_ms_ex function address */
+    void (*receive_callback_ex)(void *user, uint16_t row, uint16_t col, multi_button_t *data);      /**< point to a receive_callback_ex function address */
+    uint8_t (*matrix_select_row_ex)(void *user, uint16_t row);                                      /**< point to a matrix_select_row_ex function address */
+    uint8_t (*matrix_read_row_timestamp_ex)(void *user, uint32_t *col_array, multi_button_time_t *t);    /**< point to a matrix_read_row_timestamp_ex function address */
+    void *user;                                                                                     /**< user context passed to the hooks */
+    multi_button_single_t *button;                                                                  /**< buttons */
+#if (MULTI_BUTTON_NUMBER > 0)
+    multi_button_single_t button_buffer[MULTI_BUTTON_NUMBER];                                       /**< inline button storage */
+#endif
+    multi_button_time_t check_time;                                                                 /**< check time */
+    multi_button_time_t last_timestamp;                                                             /**< last read timestamp */
+    uint32_t clock_step_cnt;                                                                        /**< backward clock steps */
+    uint32_t state[MULTI_BUTTON_ROW_NUMBER];                                                        /**< debounced down state bitmap of each row */
+    uint32_t pending[MULTI_BUTTON_ROW_NUMBER];                                                      /**< debounce pending bitmap of each row */
+    uint32_t active[MULTI_BUTTON_ROW_NUMBER];                                                       /**< gesture or typematic active bitmap of each row */
+    uint8_t inited;                                                                                 /**< inited flag */
+    uint8_t row;                                                                                    /**< row */
+    uint8_t col;                                                                                    /**< col */
+    uint32_t short_time;                                                                            /**< short time */
+    uint32_t long_time;                                                                             /**< long time */
+    uint32_t repeat_time;                                                                           /**< repeat time */
+    uint32_t interval;                                                                              /**< interval */
+    uint32_t timeout;                                                                               /**< timeout */
+    uint32_t repeat_cnt;                                                                            /**< repeat cnt */
+    uint32_t period;                                                                                /**< period */
+#if (MULTI_BUTTON_FEATURE_TYPEMATIC != 0)
+    uint8_t typematic;                                                                              /**< typematic enable */
+    uint8_t typematic_acceleration;                                                                 /**< typematic acceleration */
+    uint32_t typematic_delay;                                                                       /**< typematic delay */
+    uint32_t typematic_interval;                                                                    /**< typematic interval */
+    uint32_t typematic_min_interval;                                                                /**< typematic min interval */
+#endif
+#if (MULTI_BUTTON_FEATURE_CLICK != 0)
+    uint8_t speculative;                                                                            /**< speculative enable */
+    uint32_t speculative_id;                                                                        /**< last speculative gesture id */
+#endif
+    uint32_t seq;                                                                                   /**< next event sequence number */
+#if (MULTI_BUTTON_BATCH_LENGTH > 0)
+    multi_button_event_t batch[MULTI_BUTTON_BATCH_LENGTH];                                          /**< batched events */
+    uint16_t batch_len;                                                                             /**< batched events length */
+#endif
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+    uint32_t hold_interval;                                                                         /**< long press hold min interval */
+    uint32_t coalesce_cnt;                                                                          /**< coalesced long press hold events */
+#endif
+#if (MULTI_BUTTON_SUBSCRIBER_NUMBER > 0)
+    multi_button_subscriber_t subscriber[MULTI_BUTTON_SUBSCRIBER_NUMBER];                           /**< subscribers */
+    uint32_t subscriber_status[16];                                                                 /**< subscriber mask of each status bit */
+#endif
+#if (MULTI_BUTTON_EVENT_RING_SIZE > 0)
+    multi_button_event_slot_t event_ring[MULTI_BUTTON_EVENT_RING_SIZE];                             /**< event ring buffer */
+    _Atomic uint32_t event_head;                                                                    /**< event ring head, only written by the scan */
+    _Atomic uint32_t event_tail;                                                                    /**< event ring tail, only written by the consumer */
+    _Atomic uint32_t event_overflow;                                                                /**< dropped events */
+    uint8_t event_policy;                                                                           /**< event ring overflow policy */
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+    uint8_t hold_coalesce;                                                                          /**< long press hold coalesce enable */
+#endif
+    uint8_t event_ring_enable;                                                                      /**< event ring enable */
+#endif
 } multi_button_handle_t;
 
+/**
+ * @brief     get the button storage size of a matrix
+ * @param[in] row max row of buttons
+ * @param[in] col max col of buttons
+ * @return    storage size in bytes
+ * @note      the storage must be aligned as multi_button_single_t,
+ *            e.g. static multi_button_single_t gs_button[2 * 3]
+ */
+#define MULTI_BUTTON_STORAGE_SIZE(row, col) ((size_t)(row) * (size_t)(col) * sizeof(multi_button_single_t))
+
+/**
+ * @brief multi_button manager structure definition
+ */
+typedef struct multi_button_manager_s
+{
+    multi_button_handle_t *handle[MULTI_BUTTON_MANAGER_NUMBER];        /**< managed handles */
+    uint8_t num;                                                      /**< handle number */
+} multi_button_manager_t;
+
 /**
  * @brief multi_button information structure definition
  */
@@ -262,6 +512,127 @@ typedef struct multi_button_info_s
  */
 #define DRIVER_MULTI_BUTTON_LINK_RECEIVE_CALLBACK(HANDLE, FUC)    (HANDLE)->receive_callback = FUC
 
+/**
+ * @brief     link receive_event_callback function
+ * @param[in] HANDLE pointer to a multi_button handle structure
+ * @param[in] FUC pointer to a receive_event_callback function address
+ * @note      the event record carries the timestamp, the duration and the sequence number,
+ *            receive_callback is still called if it is linked
+ */
+#define DRIVER_MULTI_BUTTON_LINK_RECEIVE_EVENT_CALLBACK(HANDLE, FUC)    (HANDLE)->receive_event_callback = FUC
+
+#if (MULTI_BUTTON_BATCH_LENGTH > 0)
+/**
+ * @brief     link receive_batch_callback function
+ * @param[in] HANDLE pointer to a multi_button handle structure
+ * @param[in] FUC pointer to a receive_batch_callback function address
+ * @note      the events of a process are delivered at the end of the process,
+ *            only a process with more than MULTI_BUTTON_BATCH_LENGTH events calls it before the end,
+ *            receive_event_callback and receive_callback are not called if it is linked
+ */
+#define DRIVER_MULTI_BUTTON_LINK_RECEIVE_BATCH_CALLBACK(HANDLE, FUC)    (HANDLE)->receive_batch_callback = FUC
+#endif
+
+/**
+ * @brief     link matrix_select_row function
+ * @param[in] HANDLE pointer to a multi_button handle structure
+ * @param[in] FUC pointer to a matrix_select_row function address
+ * @note      optional, it drives the row low and all the other rows high in one call,
+ *            matrix_write_row is called once per row if it is not linked
+ */
+#define DRIVER_MULTI_BUTTON_LINK_MATRIX_SELECT_ROW(HANDLE, FUC)         (HANDLE)->matrix_select_row = FUC
+
+/**
+ * @brief     link matrix_read_row_timestamp function
+ * @param[in] HANDLE pointer to a multi_button handle structure
+ * @param[in] FUC pointer to a matrix_read_row_timestamp function address
+ * @note      optional, it is used instead of matrix_read_row if linked,
+ *            t is an array of col times filled with the scan time, the function overwrites
+ *            the time of each col whose edge is captured, a press or a release is timed by
+ *            the edge that started its debounce
+ */
+#define DRIVER_MULTI_BUTTON_LINK_MATRIX_READ_ROW_TIMESTAMP(HANDLE, FUC)    (HANDLE)->matrix_read_row_timestamp = FUC
+
+/**
+ * @brief     link user context
+ * @param[in] HANDLE pointer to a multi_button handle structure
+ * @param[in] USER user context pointer
+ * @note      the context is passed to all the _ex hooks and the event callbacks
+ */
+#define DRIVER_MULTI_BUTTON_LINK_USER(HANDLE, USER)                        (HANDLE)->user = USER
+
+/**
+ * @brief     link matrix_init_ex function
+ * @param[in] HANDLE pointer to a multi_button handle structure
+ * @param[in] FUC pointer to a matrix_init_ex function address
+ * @note      it is used instead of matrix_init if linked
+ */
+#define DRIVER_MULTI_BUTTON_LINK_MATRIX_INIT_EX(HANDLE, FUC)              (HANDLE)->matrix_init_ex = FUC
+
+/**
+ * @brief     link matrix_deinit_ex function
+ * @param[in] HANDLE pointer to a multi_button handle structure
+ * @param[in] FUC pointer to a matrix_deinit_ex function address
+ * @note      it is used instead of matrix_deinit if linked
+ */
+#define DRIVER_MULTI_BUTTON_LINK_MATRIX_DEINIT_EX(HANDLE, FUC)            (HANDLE)->matrix_deinit_ex = FUC
+
+/**
+ * @brief     link matrix_write_row_ex function
+ * @param[in] HANDLE pointer to a multi_button handle structure
+ * @param[in] FUC pointer to a matrix_write_row_ex function address
+ * @note      it is used instead of matrix_write_row if linked
+ */
+#define DRIVER_MULTI_BUTTON_LINK_MATRIX_WRITE_ROW_EX(HANDLE, FUC)         (HANDLE)->matrix_write_row_ex = FUC
+
+/**
+ * @brief     link matrix_read_row_ex function
+ * @param[in] HANDLE pointer to a multi_button handle structure
+ * @param[in] FUC pointer to a matrix_read_row_ex function address
+ * @note      it is used instead of matrix_read_row if linked
+ */
+#define DRIVER_MULTI_BUTTON_LINK_MATRIX_READ_ROW_EX(HANDLE, FUC)          (HANDLE)->matrix_read_row_ex = FUC
+
+/**
+ * @brief     link timestamp_read_ex function
+ * @param[in] HANDLE pointer to a multi_button handle structure
+ * @param[in] FUC pointer to a timestamp_read_ex function address
+ * @note      it is used instead of timestamp_read if linked
+ */
+#define DRIVER_MULTI_BUTTON_LINK_TIMESTAMP_READ_EX(HANDLE, FUC)           (HANDLE)->timestamp_read_ex = FUC
+
+/**
+ * @brief     link delay_ms_ex function
+ * @param[in] HANDLE pointer to a multi_button handle structure
+ * @param[in] FUC pointer to a delay_ms_ex function address
+ * @note      it is used instead of delay_ms if linked
+ */
+#define DRIVER_MULTI_BUTTON_LINK_DELAY_MS_EX(HANDLE, FUC)                 (HANDLE)->delay_ms_ex = FUC
+
+/**
+ * @brief     link receive_callback_ex function
+ * @param[in] HANDLE pointer to a multi_button handle structure
+ * @param[in] FUC pointer to a receive_callback_ex function address
+ * @note      it is used instead of receive_callback if linked
+ */
+#define DRIVER_MULTI_BUTTON_LINK_RECEIVE_CALLBACK_EX(HANDLE, FUC)         (HANDLE)->receive_callback_ex = FUC
+
+/**
+ * @brief     link matrix_select_row_ex function
+ * @param[in] HANDLE pointer to a multi_button handle structure
+ * @param[in] FUC pointer to a matrix_select_row_ex function address
+ * @note      it is used instead of matrix_select_row if linked
+ */
+#define DRIVER_MULTI_BUTTON_LINK_MATRIX_SELECT_ROW_EX(HANDLE, FUC)        (HANDLE)->matrix_select_row_ex = FUC
+
+/**
+ * @brief     link matrix_read_row_timestamp_ex function
+ * @param[in] HANDLE pointer to a multi_button handle structure
+ * @param[in] FUC pointer to a matrix_read_row_timestamp_ex function address
+ * @note      it is used instead of matrix_read_row_timestamp if linked
+ */
+#define DRIVER_MULTI_BUTTON_LINK_MATRIX_READ_ROW_TIMESTAMP_EX(HANDLE, FUC)    (HANDLE)->matrix_read_row_timestamp_ex = FUC
+
 /**
  * @}
  */
@@ -295,10 +666,32 @@ uint8_t multi_button_info(multi_button_info_t *info);
  *            - 3 linked functions is NULL
  *            - 4 row or col is invalid
  *            - 5 matrix init failed
- * @note      none
+ * @note      it uses the inline storage and needs MULTI_BUTTON_NUMBER > 0,
+ *            row is at most MULTI_BUTTON_ROW_NUMBER
  */
 uint8_t multi_button_init(multi_button_handle_t *handle, uint8_t row, uint8_t col);
 
+/**
+ * @brief     initialize the chip with a caller-provided button storage
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] row max row of buttons
+ * @param[in] col max col of buttons
+ * @param[in] *buf pointer to a button storage buffer
+ * @param[in] size buffer size in bytes
+ * @return    status code
+ *            - 0 success
+ *            - 1 gpio initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 row or col is invalid
+ *            - 5 matrix init failed
+ *            - 6 buffer is invalid
+ * @note      size must be at least MULTI_BUTTON_STORAGE_SIZE(row, col),
+ *            the buffer must stay valid until multi_button_deinit,
+ *            row is at most MULTI_BUTTON_ROW_NUMBER
+ */
+uint8_t multi_button_init_with_buffer(multi_button_handle_t *handle, uint8_t row, uint8_t col, void *buf, size_t size);
+
 /**
  * @brief     close the chip
  * @param[in] *handle pointer to a multi_button handle structure
@@ -318,7 +711,8 @@ uint8_t multi_button_deinit(multi_button_handle_t *handle);
  *            - 1 run failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the batched events are delivered at the end of each process,
+ *            a full batch is delivered at once
  */
 uint8_t multi_button_process(multi_button_handle_t *handle);
 
@@ -490,6 +884,557 @@ uint8_t multi_button_set_period(multi_button_handle_t *handle, uint32_t period);
  */
 uint8_t multi_button_get_period(multi_button_handle_t *handle, uint32_t *period);
 
+#if (MULTI_BUTTON_FEATURE_TYPEMATIC != 0)
+
+/**
+ * @brief     enable or disable the typematic repeat
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      disabling also stops the repeat of the keys already held
+ */
+uint8_t multi_button_set_typematic(multi_button_handle_t *handle, multi_button_bool_t enable);
+
+/**
+ * @brief      get the typematic repeat status
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_typematic(multi_button_handle_t *handle, multi_button_bool_t *enable);
+
+/**
+ * @brief     set typematic delay
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] us set time
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the time from the press to the first typematic repeat
+ */
+uint8_t multi_button_set_typematic_delay(multi_button_handle_t *handle, uint32_t us);
+
+/**
+ * @brief      get typematic delay
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_typematic_delay(multi_button_handle_t *handle, uint32_t *us);
+
+/**
+ * @brief     set typematic interval
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] us set time
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 us can't be 0
+ * @note      the interval between the first and the second typematic repeat
+ */
+uint8_t multi_button_set_typematic_interval(multi_button_handle_t *handle, uint32_t us);
+
+/**
+ * @brief      get typematic interval
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_typematic_interval(multi_button_handle_t *handle, uint32_t *us);
+
+/**
+ * @brief     set typematic min interval
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] us set time
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 us can't be 0
+ * @note      the interval at the max typematic rate
+ */
+uint8_t multi_button_set_typematic_min_interval(multi_button_handle_t *handle, uint32_t us);
+
+/**
+ * @brief      get typematic min interval
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *us pointer to a time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_typematic_min_interval(multi_button_handle_t *handle, uint32_t *us);
+
+/**
+ * @brief     set typematic acceleration
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] percent interval shrink percent after each repeat
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 percent > 100
+ * @note      0 means a constant rate
+ */
+uint8_t multi_button_set_typematic_acceleration(multi_button_handle_t *handle, uint8_t percent);
+
+/**
+ * @brief      get typematic acceleration
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *percent pointer to a percent buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_typematic_acceleration(multi_button_handle_t *handle, uint8_t *percent);
+
+#endif
+
+/**
+ * @brief     set the enabled gestures of a button
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] row button row
+ * @param[in] col button col
+ * @param[in] mask or'ed multi_button_status_t of the enabled gestures
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 row or col is invalid
+ * @note      disabled statuses are never reported,
+ *            if double, triple and repeat click are all disabled,
+ *            the single click is reported at the release without waiting the repeat time
+ */
+uint8_t multi_button_set_gesture(multi_button_handle_t *handle, uint8_t row, uint8_t col, uint16_t mask);
+
+/**
+ * @brief      get the enabled gestures of a button
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[in]  row button row
+ * @param[in]  col button col
+ * @param[out] *mask pointer to a mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 row or col is invalid
+ * @note       none
+ */
+uint8_t multi_button_get_gesture(multi_button_handle_t *handle, uint8_t row, uint8_t col, uint16_t *mask);
+
+#if (MULTI_BUTTON_FEATURE_CLICK != 0)
+
+/**
+ * @brief     set the max click times of a button
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] row button row
+ * @param[in] col button col
+ * @param[in] times max click times
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 row or col is invalid
+ * @note      0 means no limit,
+ *            the click is reported at the release which reaches the max times
+ */
+uint8_t multi_button_set_max_click(multi_button_handle_t *handle, uint8_t row, uint8_t col, uint16_t times);
+
+/**
+ * @brief      get the max click times of a button
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[in]  row button row
+ * @param[in]  col button col
+ * @param[out] *times pointer to a times buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 row or col is invalid
+ * @note       none
+ */
+uint8_t multi_button_get_max_click(multi_button_handle_t *handle, uint8_t row, uint8_t col, uint16_t *times);
+
+/**
+ * @brief     enable or disable the speculative click
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      a tentative click is reported at the first release with a new gesture id,
+ *            then the same id is reported with a confirm, an upgrade or a retract event
+ */
+uint8_t multi_button_set_speculative(multi_button_handle_t *handle, multi_button_bool_t enable);
+
+/**
+ * @brief      get the speculative click status
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_speculative(multi_button_handle_t *handle, multi_button_bool_t *enable);
+
+#endif
+
+/**
+ * @brief      get the debounced down state bitmap
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *rows pointer to a bitmap buffer with one word per row
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       bit n of rows[m] is set when the button at row m and col n is down
+ */
+uint8_t multi_button_get_state_bitmap(multi_button_handle_t *handle, uint32_t *rows);
+
+/**
+ * @brief      get the debounced down state of a button
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[in]  row button row
+ * @param[in]  col button col
+ * @param[out] *pressed pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 row or col is invalid
+ * @note       none
+ */
+uint8_t multi_button_get_state(multi_button_handle_t *handle, uint8_t row, uint8_t col, multi_button_bool_t *pressed);
+
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+
+/**
+ * @brief     set the long press hold min interval
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] us min interval in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      0 means a hold event in every period,
+ *            otherwise the skipped holds are counted in times of the next hold event,
+ *            times of a hold event is the number of the other holds coalesced into it in all modes,
+ *            the skipped holds left at the release are reported in one hold before the release
+ */
+uint8_t multi_button_set_hold_interval(multi_button_handle_t *handle, uint32_t us);
+
+/**
+ * @brief      get the long press hold min interval
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *us pointer to a min interval buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_hold_interval(multi_button_handle_t *handle, uint32_t *us);
+
+/**
+ * @brief      get the coalesced long press hold count
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *cnt pointer to a count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_coalesce_count(multi_button_handle_t *handle, uint32_t *cnt);
+
+/**
+ * @brief     clear the coalesced long press hold count
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t multi_button_clear_coalesce_count(multi_button_handle_t *handle);
+
+#endif
+
+/**
+ * @brief      get the backward clock step count
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *cnt pointer to a count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       a step is counted each time timestamp_read returns a time earlier than the previous one
+ */
+uint8_t multi_button_get_clock_step_count(multi_button_handle_t *handle, uint32_t *cnt);
+
+/**
+ * @brief     clear the backward clock step count
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t multi_button_clear_clock_step_count(multi_button_handle_t *handle);
+
+#if (MULTI_BUTTON_SUBSCRIBER_NUMBER > 0)
+
+/**
+ * @brief      subscribe to events
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[in]  *key_mask pointer to a key bitmap with one word per row, NULL means all keys
+ * @param[in]  status_mask subscribed status mask
+ * @param[in]  *handler pointer to a handler function address
+ * @param[in]  *ctx handler context
+ * @param[out] *id pointer to a subscriber id buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 handler or id is NULL
+ *             - 5 no free subscriber
+ * @note       bit n of key_mask[m] selects the button at row m and col n,
+ *             the handler is only called for the subscribed keys and status,
+ *             with the event ring enabled the handlers run in multi_button_event_pop and
+ *             multi_button_event_pop_batch of the consumer context, so subscribe from that context
+ */
+uint8_t multi_button_subscribe(multi_button_handle_t *handle, const uint32_t *key_mask, uint16_t status_mask,
+                               void (*handler)(void *ctx, const multi_button_event_t *event), void *ctx, uint8_t *id);
+
+/**
+ * @brief     unsubscribe from events
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] id subscriber id
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 id is invalid
+ * @note      none
+ */
+uint8_t multi_button_unsubscribe(multi_button_handle_t *handle, uint8_t id);
+
+#endif
+
+#if (MULTI_BUTTON_EVENT_RING_SIZE > 0)
+
+/**
+ * @brief     enable or disable the event ring
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      when enabled, the scan only enqueues the events and the callbacks are not called
+ */
+uint8_t multi_button_set_event_ring(multi_button_handle_t *handle, multi_button_bool_t enable);
+
+/**
+ * @brief      get the event ring status
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_event_ring(multi_button_handle_t *handle, multi_button_bool_t *enable);
+
+/**
+ * @brief     set the event ring overflow policy
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] policy overflow policy
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      with MULTI_BUTTON_OVERFLOW_DROP_OLDEST the scan overwrites the oldest unread slot,
+ *            the consumer skips the overwritten events and counts them at the next pop
+ */
+uint8_t multi_button_set_event_overflow_policy(multi_button_handle_t *handle, multi_button_overflow_policy_t policy);
+
+/**
+ * @brief      get the event ring overflow policy
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *policy pointer to an overflow policy buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_event_overflow_policy(multi_button_handle_t *handle, multi_button_overflow_policy_t *policy);
+
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+
+/**
+ * @brief     enable or disable the long press hold coalescing
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      a hold is merged into the last queued hold of the key until that hold is popped,
+ *            times of the popped hold counts the merged holds, a count not popped at the release
+ *            is reported in one more hold before the release
+ */
+uint8_t multi_button_set_hold_coalesce(multi_button_handle_t *handle, multi_button_bool_t enable);
+
+/**
+ * @brief      get the long press hold coalescing status
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t multi_button_get_hold_coalesce(multi_button_handle_t *handle, multi_button_bool_t *enable);
+
+#endif
+
+/**
+ * @brief      pop an event from the event ring
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *event pointer to an event buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 ring is empty
+ * @note       only one consumer context can pop events,
+ *             the subscribers of the popped event run before it returns
+ */
+uint8_t multi_button_event_pop(multi_button_handle_t *handle, multi_button_event_t *event);
+
+/**
+ * @brief         pop events from the event ring
+ * @param[in]     *handle pointer to a multi_button handle structure
+ * @param[out]    *event pointer to an event buffer
+ * @param[in,out] *len pointer to a length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          len is the buffer length as input and the popped length as output,
+ *                only one consumer context can pop events,
+ *                the subscribers of the popped events run before it returns
+ */
+uint8_t multi_button_event_pop_batch(multi_button_handle_t *handle, multi_button_event_t *event, uint16_t *len);
+
+/**
+ * @brief      get the dropped event count of the event ring
+ * @param[in]  *handle pointer to a multi_button handle structure
+ * @param[out] *cnt pointer to a count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the newest drops are counted by the scan, the oldest drops are counted by the consumer
+ */
+uint8_t multi_button_get_event_overflow(multi_button_handle_t *handle, uint32_t *cnt);
+
+/**
+ * @brief     clear the dropped event count of the event ring
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t multi_button_clear_event_overflow(multi_button_handle_t *handle);
+
+#endif
+
+/**
+ * @brief     initialize the manager
+ * @param[in] *manager pointer to a multi_button manager structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 manager is NULL
+ * @note      none
+ */
+uint8_t multi_button_manager_init(multi_button_manager_t *manager);
+
+/**
+ * @brief     add a handle to the manager
+ * @param[in] *manager pointer to a multi_button manager structure
+ * @param[in] *handle pointer to an initialized multi_button handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 manager or handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 manager is full
+ *            - 5 handle is already added
+ * @note      the row lines of the handles must be independent,
+ *            one manager holds at most MULTI_BUTTON_MANAGER_NUMBER handles
+ */
+uint8_t multi_button_manager_add(multi_button_manager_t *manager, multi_button_handle_t *handle);
+
+/**
+ * @brief     remove a handle from the manager
+ * @param[in] *manager pointer to a multi_button manager structure
+ * @param[in] *handle pointer to a multi_button handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 manager or handle is NULL
+ *            - 4 handle is not found
+ * @note      none
+ */
+uint8_t multi_button_manager_remove(multi_button_manager_t *manager, multi_button_handle_t *handle);
+
+/**
+ * @brief     process all handles of the manager
+ * @param[in] *manager pointer to a multi_button manager structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 manager is NULL
+ *            - 4 manager is empty
+ * @note      the same row of all handles is selected together and shares one settle delay,
+ *            the events of each handle keep the order of multi_button_process,
+ *            a failed handle is skipped for the rest of the pass and the others go on,
+ *            all the handles run in the calling thread, there is no worker pool,
+ *            the driver keeps no global state, so managers with different handles
+ *            can be processed in parallel from the threads of the caller
+ */
+uint8_t multi_button_manager_process(multi_button_manager_t *manager);
+
 /**
  * @}
  */
@@ -0,0 +1,240 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_multi_button.hpp
+ * @brief     driver multi_button c++ convenience wrapper header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MULTI_BUTTON_HPP
+#define DRIVER_MULTI_BUTTON_HPP
+
+#include "driver_multi_button.h"
+#include <cstddef>
+#include <cstdint>
+
+#if (__cplusplus < 201703L)
+    #error "driver_multi_button.hpp needs C++17"
+#endif
+
+/**
+ * @defgroup multi_button_cpp_driver multi_button c++ driver function
+ * @brief    multi_button c++ convenience wrapper modules over the c driver
+ * @ingroup  multi_button_driver
+ * @{
+ */
+
+namespace multi_button
+{
+
+/**
+ * @brief default timing policy definition
+ * @note  a user timing policy has the same static constexpr members
+ */
+struct DefaultTiming
+{
+    static constexpr uint32_t timeout_us = 1000 * 1000;            /**< 1s */
+    static constexpr uint32_t interval_us = 5 * 1000;              /**< 5ms */
+    static constexpr uint32_t short_time_us = 1000 * 1000;         /**< 1s */
+    static constexpr uint32_t long_time_us = 3 * 1000 * 1000;      /**< 3s */
+    static constexpr uint32_t repeat_time_us = 200 * 1000;         /**< 200ms */
+    static constexpr uint32_t repeat_cnt = 2;                      /**< 2 */
+    static constexpr uint32_t period_us = 200 * 1000;              /**< 200ms */
+    static constexpr uint16_t gesture = 0xFFFF;                    /**< all gestures */
+};
+
+/**
+ * @brief multi_button matrix convenience wrapper class definition
+ * @note  it only binds a static Hal and a Timing policy to one c driver handle,
+ *        driver_multi_button.c must be linked and the decode runs in the c driver,
+ *        Hal is a static policy with matrix_init, matrix_deinit, matrix_write_row,
+ *        matrix_read_row, timestamp_read, delay_ms, debug_print and receive,
+ *        the hooks keep the signatures of the c driver without the user context
+ *        and are called through the function pointers of the handle,
+ *        receive takes a const multi_button_event_t reference,
+ *        Timing is checked at compile time and set with the runtime setters in init,
+ *        build with MULTI_BUTTON_NUMBER 0 so the button storage is exactly Rows * Cols,
+ *        the event ring needs c11 atomics and is not supported here
+ */
+template <uint8_t Rows, uint8_t Cols, class Timing, class Hal>
+class Matrix
+{
+    static_assert((Rows >= 1) && (Rows <= MULTI_BUTTON_ROW_NUMBER), "Rows is invalid");
+    static_assert((Cols >= 1) && (Cols <= 32), "Cols is invalid");
+    static_assert(Timing::short_time_us < Timing::long_time_us, "short time must be less than long time");
+    static_assert(Timing::interval_us < Timing::repeat_time_us, "interval must be less than repeat time");
+    static_assert(MULTI_BUTTON_EVENT_RING_SIZE == 0, "the event ring is not supported in c++");
+    
+    public:
+        static constexpr uint8_t rows = Rows;                      /**< max row of buttons */
+        static constexpr uint8_t cols = Cols;                      /**< max col of buttons */
+        static constexpr std::size_t size = (std::size_t)Rows * Cols;       /**< button number */
+        
+        /**
+         * @brief constructor
+         * @note  none
+         */
+        Matrix() = default;
+        
+        Matrix(const Matrix &) = delete;
+        Matrix &operator=(const Matrix &) = delete;
+        
+        /**
+         * @brief  init the matrix
+         * @return status code
+         *         - 0 success
+         *         - 1 init failed
+         * @note   the hooks are linked and the timings are set by the c driver setters here
+         */
+        uint8_t init()
+        {
+            uint8_t i;
+            uint8_t j;
+            
+            DRIVER_MULTI_BUTTON_LINK_INIT(&m_handle, multi_button_handle_t);
+            DRIVER_MULTI_BUTTON_LINK_MATRIX_INIT(&m_handle, Hal::matrix_init);
+            DRIVER_MULTI_BUTTON_LINK_MATRIX_DEINIT(&m_handle, Hal::matrix_deinit);
+            DRIVER_MULTI_BUTTON_LINK_MATRIX_WRITE_ROW(&m_handle, Hal::matrix_write_row);
+            DRIVER_MULTI_BUTTON_LINK_MATRIX_READ_ROW(&m_handle, Hal::matrix_read_row);
+            DRIVER_MULTI_BUTTON_LINK_TIMESTAMP_READ(&m_handle, Hal::timestamp_read);
+            DRIVER_MULTI_BUTTON_LINK_DELAY_MS(&m_handle, Hal::delay_ms);
+            DRIVER_MULTI_BUTTON_LINK_DEBUG_PRINT(&m_handle, Hal::debug_print);
+            DRIVER_MULTI_BUTTON_LINK_RECEIVE_EVENT_CALLBACK(&m_handle, a_receive);
+            if (multi_button_init_with_buffer(&m_handle, Rows, Cols, m_button, sizeof(m_button)) != 0)
+            {
+                return 1;
+            }
+            
+            if ((multi_button_set_timeout(&m_handle, Timing::timeout_us) != 0) ||
+                (multi_button_set_interval(&m_handle, Timing::interval_us) != 0) ||
+                (multi_button_set_short_time(&m_handle, Timing::short_time_us) != 0) ||
+                (multi_button_set_long_time(&m_handle, Timing::long_time_us) != 0) ||
+                (multi_button_set_repeat_time(&m_handle, Timing::repeat_time_us) != 0) ||
+                (multi_button_set_repeat_cnt(&m_handle, Timing::repeat_cnt) != 0) ||
+                (multi_button_set_period(&m_handle, Timing::period_us) != 0))
+            {
+                (void)multi_button_deinit(&m_handle);
+                
+                return 1;
+            }
+            if constexpr (Timing::gesture != 0xFFFF)
+            {
+                for (i = 0; i < Rows; i++)
+                {
+                    for (j = 0; j < Cols; j++)
+                    {
+                        (void)multi_button_set_gesture(&m_handle, i, j, Timing::gesture);
+                    }
+                }
+            }
+            
+            return 0;
+        }
+        
+        /**
+         * @brief  deinit the matrix
+         * @return status code
+         *         - 0 success
+         *         - 1 deinit failed
+         * @note   none
+         */
+        uint8_t deinit()
+        {
+            return (multi_button_deinit(&m_handle) != 0) ? 1 : 0;
+        }
+        
+        /**
+         * @brief  process the matrix
+         * @return status code
+         *         - 0 success
+         *         - 1 run failed
+         * @note   none
+         */
+        uint8_t process()
+        {
+            return (multi_button_process(&m_handle) != 0) ? 1 : 0;
+        }
+        
+        /**
+         * @brief  get the debounced down state of a key
+         * @return true if the key is down
+         * @note   the key is checked at compile time
+         */
+        template <uint8_t Row, uint8_t Col>
+        bool pressed() const
+        {
+            static_assert((Row < Rows) && (Col < Cols), "key is out of the matrix");
+            
+            return ((m_handle.state[Row] >> Col) & 0x1) != 0;
+        }
+        
+        /**
+         * @brief  get the debounced down state bitmap of a row
+         * @return row bitmap
+         * @note   the row is checked at compile time
+         */
+        template <uint8_t Row>
+        uint32_t row_state() const
+        {
+            static_assert(Row < Rows, "row is out of the matrix");
+            
+            return m_handle.state[Row];
+        }
+        
+        /**
+         * @brief  get the c driver handle
+         * @return reference to the handle
+         * @note   for the settings without a timing member, e.g. typematic
+         */
+        multi_button_handle_t &handle()
+        {
+            return m_handle;
+        }
+    
+    private:
+        static void a_receive(void *user, multi_button_event_t *event)
+        {
+            (void)user;
+            
+            Hal::receive(*event);
+        }
+        
+        multi_button_handle_t m_handle;                            /**< c driver handle */
+        multi_button_single_t m_button[Rows * Cols];               /**< button storage */
+};
+
+}
+
+/**
+ * @}
+ */
+
+#endif
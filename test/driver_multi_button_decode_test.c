@@ -0,0 +1,823 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_multi_button_decode_test.c
+ * @brief     driver multi_button decode test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2023-11-30
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2023/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_multi_button_decode_test.h"
+
+/**
+ * @brief decode test definition
+ */
+#define DECODE_TEST_SCAN_MS        5            /**< virtual scan period in ms */
+#define DECODE_TEST_LOG_LENGTH     128          /**< event log length */
+
+/**
+ * @brief decode test context structure definition
+ */
+typedef struct decode_test_s
+{
+    uint64_t now_us;                                        /**< virtual clock in us */
+    uint16_t row;                                           /**< selected row */
+    uint32_t key[2];                                        /**< pressed key bitmap of each row */
+    multi_button_event_t event[DECODE_TEST_LOG_LENGTH];     /**< event log */
+    uint16_t len;                                           /**< event log length */
+} decode_test_t;
+
+static multi_button_handle_t gs_handle;        /**< multi_button handle */
+static decode_test_t gs_test;                  /**< decode test context */
+
+/**
+ * @brief     virtual matrix init
+ * @param[in] *user pointer to the test context
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_decode_matrix_init(void *user)
+{
+    (void)user;
+    
+    return 0;
+}
+
+/**
+ * @brief     virtual matrix deinit
+ * @param[in] *user pointer to the test context
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_decode_matrix_deinit(void *user)
+{
+    (void)user;
+    
+    return 0;
+}
+
+/**
+ * @brief     virtual matrix write row
+ * @param[in] *user pointer to the test context
+ * @param[in] num row number
+ * @param[in] level row level
+ * @return    status code
+ *            - 0 success
+ * @note      a low level selects the row
+ */
+static uint8_t a_decode_matrix_write_row(void *user, uint16_t num, uint8_t level)
+{
+    decode_test_t *test = (decode_test_t *)user;
+    
+    if (level == 0)
+    {
+        test->row = num;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      virtual matrix read row
+ * @param[in]  *user pointer to the test context
+ * @param[out] *col_array pointer to a col buffer
+ * @return     status code
+ *             - 0 success
+ * @note       a pressed key reads low
+ */
+static uint8_t a_decode_matrix_read_row(void *user, uint32_t *col_array)
+{
+    decode_test_t *test = (decode_test_t *)user;
+    
+    *col_array = 0xFFFFFFFFU;
+    if (test->row < 2)
+    {
+        *col_array = ~test->key[test->row];
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      virtual clock read
+ * @param[in]  *user pointer to the test context
+ * @param[out] *t pointer to a time structure
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+static uint8_t a_decode_timestamp_read(void *user, multi_button_time_t *t)
+{
+    decode_test_t *test = (decode_test_t *)user;
+    
+    t->s = test->now_us / 1000000;
+    t->us = (uint32_t)(test->now_us % 1000000);
+    
+    return 0;
+}
+
+/**
+ * @brief     virtual delay
+ * @param[in] *user pointer to the test context
+ * @param[in] ms time in ms
+ * @note      it moves the virtual clock
+ */
+static void a_decode_delay_ms(void *user, uint32_t ms)
+{
+    decode_test_t *test = (decode_test_t *)user;
+    
+    test->now_us += (uint64_t)ms * 1000;
+}
+
+/**
+ * @brief     event log callback
+ * @param[in] *user pointer to the test context
+ * @param[in] *event pointer to an event structure
+ * @note      none
+ */
+static void a_decode_receive_event_callback(void *user, multi_button_event_t *event)
+{
+    decode_test_t *test = (decode_test_t *)user;
+    
+    if (test->len < DECODE_TEST_LOG_LENGTH)
+    {
+        test->event[test->len] = *event;
+        test->len++;
+    }
+}
+
+/**
+ * @brief     init the handle on the virtual matrix
+ * @param[in] col max col of buttons
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      it uses 2 rows
+ */
+static uint8_t a_decode_init(uint8_t col)
+{
+    /* reset the virtual matrix and clock */
+    memset(&gs_test, 0, sizeof(decode_test_t));
+    gs_test.now_us = 7200ULL * 1000000;
+    gs_test.row = 0xFFFF;
+    
+    /* link interface function */
+    DRIVER_MULTI_BUTTON_LINK_INIT(&gs_handle, multi_button_handle_t);
+    DRIVER_MULTI_BUTTON_LINK_MATRIX_INIT_EX(&gs_handle, a_decode_matrix_init);
+    DRIVER_MULTI_BUTTON_LINK_MATRIX_DEINIT_EX(&gs_handle, a_decode_matrix_deinit);
+    DRIVER_MULTI_BUTTON_LINK_MATRIX_WRITE_ROW_EX(&gs_handle, a_decode_matrix_write_row);
+    DRIVER_MULTI_BUTTON_LINK_MATRIX_READ_ROW_EX(&gs_handle, a_decode_matrix_read_row);
+    DRIVER_MULTI_BUTTON_LINK_TIMESTAMP_READ_EX(&gs_handle, a_decode_timestamp_read);
+    DRIVER_MULTI_BUTTON_LINK_DELAY_MS_EX(&gs_handle, a_decode_delay_ms);
+    DRIVER_MULTI_BUTTON_LINK_DEBUG_PRINT(&gs_handle, multi_button_interface_debug_print);
+    DRIVER_MULTI_BUTTON_LINK_RECEIVE_EVENT_CALLBACK(&gs_handle, a_decode_receive_event_callback);
+    DRIVER_MULTI_BUTTON_LINK_USER(&gs_handle, (void *)&gs_test);
+    
+    /* init */
+    if (multi_button_init(&gs_handle, 2, col) != 0)
+    {
+        multi_button_interface_debug_print("multi_button: init failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run the scan on the virtual clock
+ * @param[in] ms run time in ms
+ * @note      none
+ */
+static void a_decode_run(uint32_t ms)
+{
+    uint32_t i;
+    
+    for (i = 0; i < ms / DECODE_TEST_SCAN_MS; i++)
+    {
+        gs_test.now_us += DECODE_TEST_SCAN_MS * 1000;
+        (void)multi_button_process(&gs_handle);
+    }
+}
+
+#if (MULTI_BUTTON_FEATURE_CLICK != 0) || (MULTI_BUTTON_FEATURE_TYPEMATIC != 0)
+/**
+ * @brief     get the time from one event to another
+ * @param[in] *from pointer to the first event
+ * @param[in] *to pointer to the second event
+ * @return    time in us
+ * @note      none
+ */
+static int64_t a_decode_diff_us(const multi_button_event_t *from, const multi_button_event_t *to)
+{
+    return ((int64_t)to->t.s - (int64_t)from->t.s) * 1000000 + ((int64_t)to->t.us - (int64_t)from->t.us);
+}
+#endif
+
+/**
+ * @brief     find an event in the log
+ * @param[in] status event status
+ * @param[in] start first log index to search
+ * @return    log index, the log length means not found
+ * @note      none
+ */
+static uint16_t a_decode_find(uint16_t status, uint16_t start)
+{
+    uint16_t i;
+    
+    for (i = start; i < gs_test.len; i++)
+    {
+        if (gs_test.event[i].status == status)
+        {
+            break;
+        }
+    }
+    
+    return i;
+}
+
+#if (MULTI_BUTTON_FEATURE_TYPEMATIC != 0)
+/**
+ * @brief  typematic test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the repeats are at the deadlines press + delay and then + interval,
+ *         the interval shrinks by the acceleration down to the min interval
+ */
+static uint8_t a_decode_typematic_test(void)
+{
+    uint16_t i;
+    uint16_t press;
+    uint16_t release;
+    uint16_t times;
+    uint32_t interval;
+    uint32_t step;
+    int64_t expect;
+    const multi_button_event_t *last;
+    
+    if (a_decode_init(1) != 0)
+    {
+        return 1;
+    }
+    (void)multi_button_set_typematic(&gs_handle, MULTI_BUTTON_BOOL_TRUE);
+    (void)multi_button_set_typematic_delay(&gs_handle, 500 * 1000);
+    (void)multi_button_set_typematic_interval(&gs_handle, 100 * 1000);
+    (void)multi_button_set_typematic_min_interval(&gs_handle, 40 * 1000);
+    (void)multi_button_set_typematic_acceleration(&gs_handle, 20);
+    
+    /* hold the key for 1.5s */
+    a_decode_run(100);
+    gs_test.key[0] = 1 << 0;
+    a_decode_run(1500);
+    gs_test.key[0] = 0;
+    a_decode_run(500);
+    (void)multi_button_deinit(&gs_handle);
+    
+    /* check the deadlines */
+    press = a_decode_find(MULTI_BUTTON_STATUS_PRESS, 0);
+    release = a_decode_find(MULTI_BUTTON_STATUS_RELEASE, 0);
+    if ((press >= gs_test.len) || (release >= gs_test.len))
+    {
+        multi_button_interface_debug_print("multi_button: typematic press or release is lost.\n");
+        
+        return 1;
+    }
+    last = &gs_test.event[press];
+    expect = 500 * 1000;
+    interval = 100 * 1000;
+    times = 0;
+    for (i = a_decode_find(MULTI_BUTTON_STATUS_TYPEMATIC, 0); i < gs_test.len; i = a_decode_find(MULTI_BUTTON_STATUS_TYPEMATIC, i + 1))
+    {
+        times++;
+        if (i > release)
+        {
+            multi_button_interface_debug_print("multi_button: typematic repeat after the release.\n");
+            
+            return 1;
+        }
+        if (gs_test.event[i].times != times)
+        {
+            multi_button_interface_debug_print("multi_button: typematic times %d is not %d.\n", gs_test.event[i].times, times);
+            
+            return 1;
+        }
+        if (a_decode_diff_us(last, &gs_test.event[i]) != expect)
+        {
+            multi_button_interface_debug_print("multi_button: typematic repeat %d is %dus after the last one, not %dus.\n",
+                                               times, (int)a_decode_diff_us(last, &gs_test.event[i]), (int)expect);
+            
+            return 1;
+        }
+        last = &gs_test.event[i];
+        expect = interval;
+        step = interval * 20 / 100;
+        interval = (interval - step > 40 * 1000) ? (interval - step) : (40 * 1000);
+    }
+    
+    /* the min interval must be reached */
+    if (times < 8)
+    {
+        multi_button_interface_debug_print("multi_button: typematic only repeats %d times.\n", times);
+        
+        return 1;
+    }
+    multi_button_interface_debug_print("multi_button: typematic repeats %d times and check passed.\n", times);
+    
+    return 0;
+}
+#endif
+
+#if (MULTI_BUTTON_FEATURE_CLICK != 0)
+/**
+ * @brief  max click test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   a button with max click 2 reports the double click at the second release
+ *         and the third press starts a new click
+ */
+static uint8_t a_decode_max_click_test(void)
+{
+    uint8_t i;
+    uint16_t release;
+    uint16_t click;
+    
+    if (a_decode_init(1) != 0)
+    {
+        return 1;
+    }
+    (void)multi_button_set_max_click(&gs_handle, 1, 0, 2);
+    
+    /* tap 3 times in the repeat time */
+    a_decode_run(100);
+    for (i = 0; i < 3; i++)
+    {
+        gs_test.key[1] = 1 << 0;
+        a_decode_run(100);
+        gs_test.key[1] = 0;
+        a_decode_run(100);
+    }
+    a_decode_run(1500);
+    (void)multi_button_deinit(&gs_handle);
+    
+    /* check the double click at the second release */
+    release = a_decode_find(MULTI_BUTTON_STATUS_RELEASE, 0);
+    release = a_decode_find(MULTI_BUTTON_STATUS_RELEASE, release + 1);
+    click = a_decode_find(MULTI_BUTTON_STATUS_DOUBLE_CLICK, 0);
+    if ((release >= gs_test.len) || (click >= gs_test.len))
+    {
+        multi_button_interface_debug_print("multi_button: max click release or double click is lost.\n");
+        
+        return 1;
+    }
+    if ((gs_test.event[click].times != 2) || (gs_test.event[click].row != 1) ||
+        (a_decode_diff_us(&gs_test.event[release], &gs_test.event[click]) != 0))
+    {
+        multi_button_interface_debug_print("multi_button: max click double click is not at the second release.\n");
+        
+        return 1;
+    }
+    
+    /* the third press is a new single click */
+    if ((a_decode_find(MULTI_BUTTON_STATUS_TRIPLE_CLICK, 0) < gs_test.len) ||
+        (a_decode_find(MULTI_BUTTON_STATUS_REPEAT_CLICK, 0) < gs_test.len) ||
+        (a_decode_find(MULTI_BUTTON_STATUS_SINGLE_CLICK, click) >= gs_test.len))
+    {
+        multi_button_interface_debug_print("multi_button: max click third press is not a new click.\n");
+        
+        return 1;
+    }
+    multi_button_interface_debug_print("multi_button: max click check passed.\n");
+    
+    return 0;
+}
+#endif
+
+#if (MULTI_BUTTON_EVENT_RING_SIZE > 0)
+/**
+ * @brief      fill the ring over its size and pop it
+ * @param[in]  policy overflow policy
+ * @param[out] *first pointer to a first popped seq buffer
+ * @param[out] *popped pointer to a popped length buffer
+ * @param[out] *overflow pointer to an overflow count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       8 more taps than the ring holds are queued before the first pop
+ */
+static uint8_t a_decode_ring_run(multi_button_overflow_policy_t policy, uint32_t *first, uint32_t *popped, uint32_t *overflow)
+{
+    uint32_t i;
+    multi_button_event_t event;
+    
+    if (a_decode_init(1) != 0)
+    {
+        return 1;
+    }
+    (void)multi_button_set_gesture(&gs_handle, 0, 0, MULTI_BUTTON_STATUS_PRESS | MULTI_BUTTON_STATUS_RELEASE);
+    (void)multi_button_set_event_ring(&gs_handle, MULTI_BUTTON_BOOL_TRUE);
+    (void)multi_button_set_event_overflow_policy(&gs_handle, policy);
+    
+    /* tap without popping */
+    for (i = 0; i < MULTI_BUTTON_EVENT_RING_SIZE / 2 + 8; i++)
+    {
+        gs_test.key[0] = 1 << 0;
+        a_decode_run(20);
+        gs_test.key[0] = 0;
+        a_decode_run(20);
+    }
+    
+    /* pop all and check the seq */
+    *popped = 0;
+    while (multi_button_event_pop(&gs_handle, &event) == 0)
+    {
+        if (*popped == 0)
+        {
+            *first = event.seq;
+        }
+        else if (event.seq != *first + *popped)
+        {
+            multi_button_interface_debug_print("multi_button: ring seq %d is not %d.\n", event.seq, *first + *popped);
+            (void)multi_button_deinit(&gs_handle);
+            
+            return 1;
+        }
+        (*popped)++;
+    }
+    (void)multi_button_get_event_overflow(&gs_handle, overflow);
+    (void)multi_button_deinit(&gs_handle);
+    
+    return 0;
+}
+
+/**
+ * @brief  ring overflow test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   drop newest keeps the first events and drop oldest keeps the last events,
+ *         both count every lost event
+ */
+static uint8_t a_decode_ring_overflow_test(void)
+{
+    uint32_t total;
+    uint32_t first;
+    uint32_t popped;
+    uint32_t overflow;
+    
+    total = (MULTI_BUTTON_EVENT_RING_SIZE / 2 + 8) * 2;
+    
+    /* drop newest */
+    if (a_decode_ring_run(MULTI_BUTTON_OVERFLOW_DROP_NEWEST, &first, &popped, &overflow) != 0)
+    {
+        return 1;
+    }
+    if ((popped != MULTI_BUTTON_EVENT_RING_SIZE) || (popped + overflow != total) || (first != 0))
+    {
+        multi_button_interface_debug_print("multi_button: drop newest pops %d from seq %d with %d overflow.\n", popped, first, overflow);
+        
+        return 1;
+    }
+    
+    /* drop oldest */
+    if (a_decode_ring_run(MULTI_BUTTON_OVERFLOW_DROP_OLDEST, &first, &popped, &overflow) != 0)
+    {
+        return 1;
+    }
+    if ((popped != MULTI_BUTTON_EVENT_RING_SIZE) || (popped + overflow != total) || (first != overflow))
+    {
+        multi_button_interface_debug_print("multi_button: drop oldest pops %d from seq %d with %d overflow.\n", popped, first, overflow);
+        
+        return 1;
+    }
+    multi_button_interface_debug_print("multi_button: ring overflow check passed.\n");
+    
+    return 0;
+}
+
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+/**
+ * @brief  pop all events of the ring to the event log
+ * @note   none
+ */
+static void a_decode_pop(void)
+{
+    multi_button_event_t event;
+    
+    while (multi_button_event_pop(&gs_handle, &event) == 0)
+    {
+        a_decode_receive_event_callback(&gs_test, &event);
+    }
+}
+
+/**
+ * @brief     run the scan and pop the ring on the virtual clock
+ * @param[in] ms run time in ms
+ * @param[in] pop_ms pop period in ms
+ * @note      none
+ */
+static void a_decode_run_pop(uint32_t ms, uint32_t pop_ms)
+{
+    uint32_t i;
+    
+    for (i = 0; i < ms / DECODE_TEST_SCAN_MS; i++)
+    {
+        gs_test.now_us += DECODE_TEST_SCAN_MS * 1000;
+        (void)multi_button_process(&gs_handle);
+        if (((i + 1) % (pop_ms / DECODE_TEST_SCAN_MS)) == 0)
+        {
+            a_decode_pop();
+        }
+    }
+}
+
+/**
+ * @brief      hold the key for 7s with the ring
+ * @param[in]  coalesce bool value
+ * @param[in]  pop_ms pop period in ms
+ * @param[out] *holds pointer to a hold event count buffer
+ * @param[out] *period pointer to a hold period count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       all holds must be popped before the release and the long press end
+ */
+static uint8_t a_decode_hold_run(multi_button_bool_t coalesce, uint32_t pop_ms, uint16_t *holds, uint32_t *period)
+{
+    uint16_t i;
+    uint16_t hold;
+    uint16_t release;
+    uint16_t end;
+    
+    if (a_decode_init(1) != 0)
+    {
+        return 1;
+    }
+    (void)multi_button_set_event_ring(&gs_handle, MULTI_BUTTON_BOOL_TRUE);
+    (void)multi_button_set_hold_coalesce(&gs_handle, coalesce);
+    
+    /* hold the key for 7s */
+    a_decode_run_pop(200, pop_ms);
+    gs_test.key[0] = 1 << 0;
+    a_decode_run_pop(7000, pop_ms);
+    gs_test.key[0] = 0;
+    a_decode_run_pop(600, pop_ms);
+    a_decode_pop();
+    (void)multi_button_deinit(&gs_handle);
+    
+    /* count the hold periods */
+    *holds = 0;
+    *period = 0;
+    hold = gs_test.len;
+    for (i = a_decode_find(MULTI_BUTTON_STATUS_LONG_PRESS_HOLD, 0); i < gs_test.len; i = a_decode_find(MULTI_BUTTON_STATUS_LONG_PRESS_HOLD, i + 1))
+    {
+        (*holds)++;
+        *period += 1 + gs_test.event[i].times;
+        hold = i;
+    }
+    
+    /* check the order */
+    release = a_decode_find(MULTI_BUTTON_STATUS_RELEASE, 0);
+    end = a_decode_find(MULTI_BUTTON_STATUS_LONG_PRESS_END, 0);
+    if ((hold >= gs_test.len) || (release >= gs_test.len) || (end >= gs_test.len) || (hold > release) || (release > end))
+    {
+        multi_button_interface_debug_print("multi_button: hold %d, release %d and long press end %d are out of order.\n", hold, release, end);
+        
+        return 1;
+    }
+    if (gs_test.event[hold].duration_us > gs_test.event[release].duration_us)
+    {
+        multi_button_interface_debug_print("multi_button: last hold is longer than the press.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  hold coalescing test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   a slow consumer gets fewer holds, their times add up to the hold periods of a fast consumer
+ */
+static uint8_t a_decode_hold_coalesce_test(void)
+{
+    uint16_t holds;
+    uint16_t coalesced_holds;
+    uint32_t period;
+    uint32_t coalesced_period;
+    
+    /* pop in every scan */
+    if (a_decode_hold_run(MULTI_BUTTON_BOOL_FALSE, DECODE_TEST_SCAN_MS, &holds, &period) != 0)
+    {
+        return 1;
+    }
+    if (holds != period)
+    {
+        multi_button_interface_debug_print("multi_button: fast consumer gets coalesced holds.\n");
+        
+        return 1;
+    }
+    
+    /* pop every 700ms */
+    if (a_decode_hold_run(MULTI_BUTTON_BOOL_TRUE, 700, &coalesced_holds, &coalesced_period) != 0)
+    {
+        return 1;
+    }
+    if ((coalesced_holds >= holds) || (coalesced_period != period))
+    {
+        multi_button_interface_debug_print("multi_button: %d coalesced holds count %d periods, not %d.\n",
+                                           coalesced_holds, coalesced_period, period);
+        
+        return 1;
+    }
+    multi_button_interface_debug_print("multi_button: hold coalescing check passed.\n");
+    
+    return 0;
+}
+#endif
+#endif
+
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+/**
+ * @brief  clock step test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the clock steps back by 1h in a double click and in a long press,
+ *         both gestures must be decoded and the press time must not count the step
+ */
+static uint8_t a_decode_clock_step_test(void)
+{
+    uint16_t press;
+    uint16_t release;
+    uint32_t cnt;
+    int64_t elapsed;
+    
+    if (a_decode_init(2) != 0)
+    {
+        return 1;
+    }
+    
+    /* double click with a step in the gap */
+    a_decode_run(100);
+    gs_test.key[0] = 1 << 0;
+    a_decode_run(100);
+    gs_test.key[0] = 0;
+    a_decode_run(50);
+    gs_test.now_us -= 3600ULL * 1000000;
+    a_decode_run(50);
+    gs_test.key[0] = 1 << 0;
+    a_decode_run(100);
+    gs_test.key[0] = 0;
+    a_decode_run(1500);
+    
+    /* 4s long press with a step after 1.3s */
+    press = gs_test.len;
+    elapsed = -(int64_t)gs_test.now_us;
+    gs_test.key[0] = 1 << 1;
+    a_decode_run(1300);
+    gs_test.now_us -= 3600ULL * 1000000;
+    a_decode_run(2700);
+    gs_test.key[0] = 0;
+    elapsed += (int64_t)gs_test.now_us + 3600LL * 1000000;
+    a_decode_run(600);
+    (void)multi_button_get_clock_step_count(&gs_handle, &cnt);
+    (void)multi_button_deinit(&gs_handle);
+    
+    /* check the step count */
+    if (cnt != 2)
+    {
+        multi_button_interface_debug_print("multi_button: clock step count %d is not 2.\n", cnt);
+        
+        return 1;
+    }
+#if (MULTI_BUTTON_FEATURE_CLICK != 0)
+    
+    /* check the double click */
+    if ((a_decode_find(MULTI_BUTTON_STATUS_DOUBLE_CLICK, 0) >= press) ||
+        (gs_test.event[a_decode_find(MULTI_BUTTON_STATUS_DOUBLE_CLICK, 0)].times != 2))
+    {
+        multi_button_interface_debug_print("multi_button: double click is lost in the clock step.\n");
+        
+        return 1;
+    }
+#endif
+    
+    /* check the long press */
+    release = a_decode_find(MULTI_BUTTON_STATUS_RELEASE, press);
+    if ((a_decode_find(MULTI_BUTTON_STATUS_LONG_PRESS_START, press) >= gs_test.len) ||
+        (a_decode_find(MULTI_BUTTON_STATUS_LONG_PRESS_END, press) >= gs_test.len) || (release >= gs_test.len))
+    {
+        multi_button_interface_debug_print("multi_button: long press is lost in the clock step.\n");
+        
+        return 1;
+    }
+    if (((int64_t)gs_test.event[release].duration_us > elapsed) ||
+        ((int64_t)gs_test.event[release].duration_us < elapsed - 4 * DECODE_TEST_SCAN_MS * 1000))
+    {
+        multi_button_interface_debug_print("multi_button: long press lasts %dus in %dus.\n",
+                                           gs_test.event[release].duration_us, (int)elapsed);
+        
+        return 1;
+    }
+    multi_button_interface_debug_print("multi_button: clock step check passed.\n");
+    
+    return 0;
+}
+#endif
+
+/**
+ * @brief  decode test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   it runs the driver on a virtual matrix and a virtual clock and needs no hardware
+ */
+uint8_t multi_button_decode_test(void)
+{
+    /* start decode test */
+    multi_button_interface_debug_print("multi_button: start decode test.\n");
+    
+#if (MULTI_BUTTON_FEATURE_TYPEMATIC != 0)
+    /* typematic test */
+    multi_button_interface_debug_print("multi_button: typematic test.\n");
+    if (a_decode_typematic_test() != 0)
+    {
+        return 1;
+    }
+#endif
+    
+#if (MULTI_BUTTON_FEATURE_CLICK != 0)
+    /* max click test */
+    multi_button_interface_debug_print("multi_button: max click test.\n");
+    if (a_decode_max_click_test() != 0)
+    {
+        return 1;
+    }
+#endif
+    
+#if (MULTI_BUTTON_EVENT_RING_SIZE > 0)
+    /* ring overflow test */
+    multi_button_interface_debug_print("multi_button: ring overflow test.\n");
+    if (a_decode_ring_overflow_test() != 0)
+    {
+        return 1;
+    }
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+    
+    /* hold coalescing test */
+    multi_button_interface_debug_print("multi_button: hold coalescing test.\n");
+    if (a_decode_hold_coalesce_test() != 0)
+    {
+        return 1;
+    }
+#endif
+#endif
+    
+#if (MULTI_BUTTON_FEATURE_LONG_PRESS != 0)
+    /* clock step test */
+    multi_button_interface_debug_print("multi_button: clock step test.\n");
+    if (a_decode_clock_step_test() != 0)
+    {
+        return 1;
+    }
+#endif
+    
+    /* finish decode test */
+    multi_button_interface_debug_print("multi_button: finish decode test.\n");
+    
+    return 0;
+}
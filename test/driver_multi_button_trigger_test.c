@@ -37,90 +37,92 @@
 #include "driver_multi_button_trigger_test.h"
 
 static multi_button_handle_t gs_handle;        /**< multi_button handle */
-static volatile uint16_t gs_flag;              /**< flag */
 
 /**
  * @brief     interface receive callback
+ * @param[in] *user pointer to the flag
  * @param[in] row requested row
  * @param[in] col requested col
  * @param[in] *data pointer to an multi_button_t structure
  * @note      none
  */
-static void a_receive_callback(uint16_t row, uint16_t col, multi_button_t *data)
+static void a_receive_callback(void *user, uint16_t row, uint16_t col, multi_button_t *data)
 {
+    volatile uint16_t *flag = (volatile uint16_t *)user;
+    
     switch (data->status)
     {
         case MULTI_BUTTON_STATUS_PRESS :
         {
-            gs_flag |= 1 << 0;
+            *flag |= 1 << 0;
             
             break;
         }
         case MULTI_BUTTON_STATUS_RELEASE :
         {
-            gs_flag |= 1 << 1;
+            *flag |= 1 << 1;
             
             break;
         }
         case MULTI_BUTTON_STATUS_SINGLE_CLICK :
         {
-            gs_flag |= 1 << 2;
+            *flag |= 1 << 2;
             multi_button_interface_debug_print("multi_button: row %d col %d irq single click.\n", row, col);
             
             break;
         }
         case MULTI_BUTTON_STATUS_DOUBLE_CLICK :
         {
-            gs_flag |= 1 << 3;
+            *flag |= 1 << 3;
             multi_button_interface_debug_print("multi_button: row %d col %d irq double click.\n", row, col);
             
             break;
         }
         case MULTI_BUTTON_STATUS_TRIPLE_CLICK :
         {
-            gs_flag |= 1 << 4;
+            *flag |= 1 << 4;
             multi_button_interface_debug_print("multi_button: row %d col %d irq triple click.\n", row, col);
             
             break;
         }
         case MULTI_BUTTON_STATUS_REPEAT_CLICK :
         {
-            gs_flag |= 1 << 5;
+            *flag |= 1 << 5;
             multi_button_interface_debug_print("multi_button: row %d col %d irq repeat click with %d times.\n", row, col, data->times);
             
             break;
         }
         case MULTI_BUTTON_STATUS_SHORT_PRESS_START :
         {
-            gs_flag |= 1 << 6;
+            *flag |= 1 << 6;
             multi_button_interface_debug_print("multi_button: row %d col %d irq short press start.\n", row, col);
             
             break;
         }
         case MULTI_BUTTON_STATUS_SHORT_PRESS_END :
         {
-            gs_flag |= 1 << 7;
+            *flag |= 1 << 7;
             multi_button_interface_debug_print("multi_button: row %d col %d irq short press end.\n", row, col);
             
             break;
         }
         case MULTI_BUTTON_STATUS_LONG_PRESS_START :
         {
-            gs_flag |= 1 << 8;
+            *flag |= 1 << 8;
             multi_button_interface_debug_print("multi_button: row %d col %d irq long press start.\n", row, col);
             
             break;
         }
         case MULTI_BUTTON_STATUS_LONG_PRESS_HOLD :
         {
-            gs_flag |= 1 << 9;
+            *flag |= 1 << 9;
             multi_button_interface_debug_print("multi_button: row %d col %d irq long press hold.\n", row, col);
             
             break;
         }
         case MULTI_BUTTON_STATUS_LONG_PRESS_END :
         {
-            gs_flag |= 1 << 10;
+            *flag |= 1 << 10;
             multi_button_interface_debug_print("multi_button: row %d col %d irq long press end.\n", row, col);
             
             break;
@@ -147,6 +149,7 @@ uint8_t multi_button_trigger_test(uint8_t row, uint8_t col)
 {
     uint8_t res;
     uint32_t timeout;
+    volatile uint16_t flag;
     multi_button_info_t info;
     
     /* link interface function */
@@ -158,7 +161,8 @@ uint8_t multi_button_trigger_test(uint8_t row, uint8_t col)
     DRIVER_MULTI_BUTTON_LINK_TIMESTAMP_READ(&gs_handle, multi_button_interface_timestamp_read);
     DRIVER_MULTI_BUTTON_LINK_DELAY_MS(&gs_handle, multi_button_interface_delay_ms);
     DRIVER_MULTI_BUTTON_LINK_DEBUG_PRINT(&gs_handle, multi_button_interface_debug_print);
-    DRIVER_MULTI_BUTTON_LINK_RECEIVE_CALLBACK(&gs_handle, a_receive_callback);
+    DRIVER_MULTI_BUTTON_LINK_RECEIVE_CALLBACK_EX(&gs_handle, a_receive_callback);
+    DRIVER_MULTI_BUTTON_LINK_USER(&gs_handle, (void *)&flag);
     
     /* get information */
     res = multi_button_info(&info);
@@ -198,13 +202,13 @@ uint8_t multi_button_trigger_test(uint8_t row, uint8_t col)
     timeout = 10000;
     
     /* init 0 */
-    gs_flag = 0;
+    flag = 0;
     
     /* check timeout */
     while (timeout != 0)
     {
         /* check the flag */
-        if ((gs_flag & 0x07FF) == 0x07FF)
+        if ((flag & 0x07FF) == 0x07FF)
         {
             break;
         }